@@ -2,7 +2,11 @@
 
 #include "mpmc_queue.hpp"
 #include "itch_protocol.hpp"
+#include "columnar_log.hpp"
+#include "compact_log.hpp"
+#include "log_index.hpp"
 #include <atomic>
+#include <memory>
 #include <thread>
 #include <string>
 #include <fcntl.h>
@@ -17,6 +21,11 @@ namespace fast_market {
  * High-Performance Asynchronous Logger
  * Uses MPMC queue to decouple parsing from I/O
  * Supports both O_DIRECT and memory-mapped file modes
+ * COLUMNAR writes per-type column chunks instead of packed structs (see
+ * ColumnarWriter); read it back with ColumnarLogReader
+ * COMPACT writes delta/varint records (see CompactEncoder); read it back
+ * with CompactLogReader
+ * enable_index() adds a sparse "<file>.idx" sidecar for IndexedLogReader
  */
 class AsyncLogger {
 public:
@@ -27,7 +36,9 @@ public:
     enum class WriteMode {
         MMAP,      // Memory-mapped file (default)
         DIRECT,    // Direct I/O (bypasses page cache)
-        BUFFERED   // Standard buffered I/O
+        BUFFERED,  // Standard buffered I/O
+        COLUMNAR,  // Struct-of-arrays row groups with a footer
+        COMPACT    // Delta/varint records through the write buffer
     };
     
     AsyncLogger(const std::string& filename, WriteMode mode = WriteMode::MMAP)
@@ -85,6 +96,18 @@ public:
         close_file();
     }
     
+    /**
+     * Write a sparse timestamp/ordinal -> offset index next to the log
+     * Call before start(). A point is added every every_records records or
+     * every every_ns of ITCH time, whichever comes first (0 disables
+     * either). Supported for MMAP, BUFFERED and COMPACT; DIRECT pads its
+     * writes and COLUMNAR has its own footer.
+     */
+    void enable_index(uint64_t every_records, uint64_t every_ns = 1'000'000'000) {
+        index_every_records_ = every_records;
+        index_every_ns_ = every_ns;
+    }
+    
     /**
      * Enqueue a message for logging
      * Non-blocking, returns false if queue is full
@@ -103,7 +126,7 @@ public:
     [[nodiscard]] size_t get_queue_size() const noexcept {
         return queue_.size();
     }
-
+    
 private:
     void open_file() {
         int flags = O_WRONLY | O_CREAT | O_TRUNC;
@@ -141,9 +164,40 @@ private:
             // Advise kernel about access pattern
             madvise(mmap_ptr_, mmap_size_, MADV_SEQUENTIAL);
         }
+        
+        if (write_mode_ == WriteMode::COLUMNAR) {
+            columnar_ = std::make_unique<ColumnarWriter>(fd_);
+        }
+        
+        if (write_mode_ == WriteMode::COMPACT) {
+            compact_ = std::make_unique<CompactEncoder>();
+            const CompactLogHeader header{CompactEncoder::MAGIC, CompactEncoder::VERSION, 0};
+            std::memcpy(write_buffer_, &header, sizeof(header));
+            buffer_offset_ = sizeof(header);
+        }
+        
+        const bool indexable = write_mode_ == WriteMode::MMAP || write_mode_ == WriteMode::BUFFERED ||
+                               write_mode_ == WriteMode::COMPACT;
+        if (indexable && (index_every_records_ != 0 || index_every_ns_ != 0)) {
+            index_ = std::make_unique<LogIndexWriter>(
+                filename_ + ".idx", write_mode_ == WriteMode::COMPACT ? LogFormat::COMPACT : LogFormat::ROW,
+                index_every_records_, index_every_ns_);
+            records_ = 0;
+        }
     }
     
     void close_file() {
+        if (index_) {
+            index_->close();
+            index_.reset();
+        }
+        
+        if (columnar_) {
+            columnar_->finish();
+            total_written_.store(columnar_->bytes_written(), std::memory_order_relaxed);
+            columnar_.reset();
+        }
+        
         if (write_mode_ == WriteMode::MMAP && mmap_ptr_ != nullptr) {
             // Sync and unmap
             msync(mmap_ptr_, mmap_size_, MS_SYNC);
@@ -186,6 +240,24 @@ private:
     }
     
     void write_message(const ParsedMessage& msg) {
+        if (write_mode_ == WriteMode::COLUMNAR) {
+            columnar_->append(msg);
+            total_written_.store(columnar_->bytes_written(), std::memory_order_relaxed);
+            return;
+        }
+        
+        if (index_) {
+            index_record(msg);
+        }
+        
+        if (write_mode_ == WriteMode::COMPACT) {
+            if (buffer_offset_ + CompactEncoder::MAX_RECORD_SIZE > BUFFER_SIZE) {
+                flush();
+            }
+            buffer_offset_ += compact_->encode(msg, write_buffer_ + buffer_offset_);
+            return;
+        }
+        
         // Serialize message to buffer
         size_t msg_size = get_message_size(msg);
         
@@ -209,6 +281,23 @@ private:
         }
     }
     
+    void index_record(const ParsedMessage& msg) {
+        const uint64_t timestamp = msg.system_event.header.timestamp.value();
+        if (index_->due(records_, timestamp)) {
+            const uint64_t written = total_written_.load(std::memory_order_relaxed);
+            index_->add(records_, timestamp, write_mode_ == WriteMode::MMAP ? written : written + buffer_offset_);
+            
+            // Compact records decode from the point on their own
+            if (compact_) {
+                if (buffer_offset_ == BUFFER_SIZE) {
+                    flush();
+                }
+                buffer_offset_ += compact_->start_segment(write_buffer_ + buffer_offset_);
+            }
+        }
+        ++records_;
+    }
+    
     void expand_mmap() {
         // Double the size
         size_t new_size = mmap_size_ * 2;
@@ -234,62 +323,14 @@ private:
     }
     
     size_t get_message_size(const ParsedMessage& msg) const {
-        switch (msg.type) {
-            case MessageType::ADD_ORDER:
-                return sizeof(AddOrderMessage);
-            case MessageType::EXECUTE_ORDER:
-                return sizeof(ExecuteOrderMessage);
-            case MessageType::EXECUTE_ORDER_WITH_PRICE:
-                return sizeof(ExecuteOrderWithPriceMessage);
-            case MessageType::ORDER_CANCEL:
-                return sizeof(OrderCancelMessage);
-            case MessageType::ORDER_DELETE:
-                return sizeof(OrderDeleteMessage);
-            case MessageType::ORDER_REPLACE:
-                return sizeof(OrderReplaceMessage);
-            case MessageType::TRADE:
-                return sizeof(TradeMessage);
-            case MessageType::SYSTEM_EVENT:
-                return sizeof(SystemEventMessage);
-            case MessageType::STOCK_DIRECTORY:
-                return sizeof(StockDirectoryMessage);
-            default:
-                return 0;
-        }
+        return MESSAGE_LENGTHS[static_cast<uint8_t>(msg.type)];
     }
     
     void serialize_message(uint8_t* dest, const ParsedMessage& msg) {
         // Simple binary serialization - just copy the struct
-        // In production, you might want a more sophisticated format
-        switch (msg.type) {
-            case MessageType::ADD_ORDER:
-                std::memcpy(dest, &msg.add_order, sizeof(AddOrderMessage));
-                break;
-            case MessageType::EXECUTE_ORDER:
-                std::memcpy(dest, &msg.execute_order, sizeof(ExecuteOrderMessage));
-                break;
-            case MessageType::EXECUTE_ORDER_WITH_PRICE:
-                std::memcpy(dest, &msg.execute_with_price, sizeof(ExecuteOrderWithPriceMessage));
-                break;
-            case MessageType::ORDER_CANCEL:
-                std::memcpy(dest, &msg.order_cancel, sizeof(OrderCancelMessage));
-                break;
-            case MessageType::ORDER_DELETE:
-                std::memcpy(dest, &msg.order_delete, sizeof(OrderDeleteMessage));
-                break;
-            case MessageType::ORDER_REPLACE:
-                std::memcpy(dest, &msg.order_replace, sizeof(OrderReplaceMessage));
-                break;
-            case MessageType::TRADE:
-                std::memcpy(dest, &msg.trade, sizeof(TradeMessage));
-                break;
-            case MessageType::SYSTEM_EVENT:
-                std::memcpy(dest, &msg.system_event, sizeof(SystemEventMessage));
-                break;
-            case MessageType::STOCK_DIRECTORY:
-                std::memcpy(dest, &msg.stock_directory, sizeof(StockDirectoryMessage));
-                break;
-        }
+        // All union members share one address, so any of them points at the
+        // decoded message; the length comes from the type
+        std::memcpy(dest, &msg.system_event, get_message_size(msg));
     }
     
     void worker_loop() {
@@ -325,6 +366,14 @@ private:
     uint8_t* write_buffer_ = nullptr;
     size_t buffer_offset_;
     
+    std::unique_ptr<ColumnarWriter> columnar_;
+    std::unique_ptr<CompactEncoder> compact_;
+    
+    std::unique_ptr<LogIndexWriter> index_;
+    uint64_t index_every_records_ = 0;
+    uint64_t index_every_ns_ = 0;
+    uint64_t records_ = 0;
+    
     std::atomic<size_t> total_written_;
 };
 
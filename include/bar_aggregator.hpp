@@ -0,0 +1,191 @@
+#pragma once
+
+#include "itch_views.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace fast_market {
+
+/**
+ * Completed OHLCV bar for one symbol
+ * Prices are ITCH fixed-point (4 decimals).
+ */
+struct Bar {
+    uint64_t start = 0;         // ITCH timestamp (ns since midnight) the interval starts at
+    uint64_t volume = 0;
+    uint64_t notional = 0;      // Sum of price * shares, in price units
+    uint32_t open = 0;
+    uint32_t high = 0;
+    uint32_t low = 0;
+    uint32_t close = 0;
+    uint32_t trades = 0;
+    uint16_t stock_locate = 0;
+    
+    // Volume-weighted average price, in price units
+    [[nodiscard]] double vwap() const noexcept {
+        return volume ? static_cast<double>(notional) / static_cast<double>(volume) : 0.0;
+    }
+};
+
+/**
+ * Counters for a BarAggregator
+ */
+struct BarStats {
+    uint64_t trades = 0;
+    uint64_t bars = 0;
+    uint64_t batches = 0;       // Sink calls
+};
+
+/**
+ * Per-symbol OHLCV/VWAP bars on fixed ITCH-timestamp intervals
+ * Pass it to the parser as a handler: trades (P), printable executions
+ * with price (C) and crosses (Q) are folded into a one-cache-line
+ * accumulator per stock_locate. Executions at the resting price (E)
+ * carry no price and need the book, so they are not counted here.
+ *
+ * Bars roll when the feed clock crosses an interval boundary: every
+ * symbol that traded in the closed interval is emitted in one batch as
+ * sink(const Bar* bars, size_t count), and symbols that did not trade get
+ * no bar. Timestamps are expected in feed order; advance() rolls on other
+ * message times, flush() emits the open interval at end of session.
+ * Run one aggregator per interval (e.g. 1 s and 1 min).
+ */
+template<typename Sink>
+class BarAggregator {
+public:
+    static constexpr uint64_t ONE_SECOND_NS = 1'000'000'000ULL;
+    static constexpr uint64_t ONE_MINUTE_NS = 60 * ONE_SECOND_NS;
+    static constexpr size_t MAX_LOCATES = 65536;
+    
+    /**
+     * @param interval_ns Bar length in nanoseconds
+     * @param sink Receives completed bars in batches
+     */
+    BarAggregator(uint64_t interval_ns, Sink sink)
+        : interval_(interval_ns)
+        , sink_(std::move(sink))
+        , accumulators_(MAX_LOCATES)
+    {
+        active_.reserve(INITIAL_ACTIVE);
+        batch_.reserve(INITIAL_ACTIVE);
+    }
+    
+    BarAggregator(const BarAggregator&) = delete;
+    BarAggregator& operator=(const BarAggregator&) = delete;
+    
+    // Parser handler callbacks
+    void on_trade(const TradeView& msg) {
+        add_trade(msg.stock_locate(), msg.price(), msg.shares(), msg.timestamp());
+    }
+    
+    void on_execute_with_price(const ExecuteOrderWithPriceView& msg) {
+        if (msg.printable() == 'Y') {
+            add_trade(msg.stock_locate(), msg.execution_price(), msg.executed_shares(), msg.timestamp());
+        }
+    }
+    
+    void on_cross_trade(const CrossTradeView& msg) {
+        if (msg.shares() != 0) {
+            add_trade(msg.stock_locate(), msg.cross_price(), msg.shares(), msg.timestamp());
+        }
+    }
+    
+    /**
+     * Fold one trade into its symbol's current bar
+     */
+    void add_trade(uint16_t stock_locate, uint32_t price, uint64_t shares, uint64_t timestamp) {
+        if (timestamp >= bar_end_) [[unlikely]] {
+            roll(timestamp);
+        }
+        Accumulator& bar = accumulators_[stock_locate];
+        if (bar.trades == 0) {
+            bar.open = bar.high = bar.low = price;
+            active_.push_back(stock_locate);
+        } else {
+            bar.high = price > bar.high ? price : bar.high;
+            bar.low = price < bar.low ? price : bar.low;
+        }
+        bar.close = price;
+        bar.volume += shares;
+        bar.notional += static_cast<uint64_t>(price) * shares;
+        ++bar.trades;
+        ++stats_.trades;
+    }
+    
+    /**
+     * Move the clock forward, emitting bars whose interval has ended
+     */
+    void advance(uint64_t timestamp) {
+        if (timestamp >= bar_end_) {
+            roll(timestamp);
+        }
+    }
+    
+    /**
+     * Emit the bars of the current interval now (e.g. at end of session)
+     */
+    void flush() {
+        emit();
+    }
+    
+    [[nodiscard]] uint64_t interval() const noexcept {
+        return interval_;
+    }
+    
+    [[nodiscard]] const BarStats& stats() const noexcept {
+        return stats_;
+    }
+    
+    [[nodiscard]] Sink& sink() noexcept {
+        return sink_;
+    }
+    
+private:
+    static constexpr size_t INITIAL_ACTIVE = 16384;
+    
+    struct alignas(64) Accumulator {
+        uint64_t volume = 0;
+        uint64_t notional = 0;
+        uint32_t open = 0;
+        uint32_t high = 0;
+        uint32_t low = 0;
+        uint32_t close = 0;
+        uint32_t trades = 0;
+    };
+    
+    [[gnu::noinline]] void roll(uint64_t timestamp) {
+        emit();
+        bar_start_ = timestamp - timestamp % interval_;
+        bar_end_ = bar_start_ + interval_;
+    }
+    
+    void emit() {
+        if (active_.empty()) {
+            return;
+        }
+        batch_.clear();
+        for (const uint16_t locate : active_) {
+            Accumulator& bar = accumulators_[locate];
+            batch_.push_back(Bar{bar_start_, bar.volume, bar.notional, bar.open, bar.high, bar.low,
+                                 bar.close, bar.trades, locate});
+            bar = Accumulator{};
+        }
+        active_.clear();
+        ++stats_.batches;
+        stats_.bars += batch_.size();
+        sink_(batch_.data(), batch_.size());
+    }
+    
+    uint64_t interval_;
+    uint64_t bar_start_ = 0;
+    uint64_t bar_end_ = 0;              // First timestamp of the next interval
+    Sink sink_;
+    std::vector<Accumulator> accumulators_;
+    std::vector<uint16_t> active_;      // Locates with trades in the current interval
+    std::vector<Bar> batch_;
+    BarStats stats_;
+};
+
+} // namespace fast_market
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "order_book.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace fast_market {
+
+/**
+ * Checkpoint file header
+ * Sections are located by byte offset from the start of the file and hold
+ * no pointers, so a checkpoint is valid wherever it is mapped. Fields are
+ * in host byte order; the file is meant for restarting on the same host.
+ */
+struct CheckpointHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t file_size;
+    uint64_t sequence;          // Next feed sequence number to apply
+    uint64_t symbol_count;
+    uint64_t symbols_offset;
+    uint64_t book_count;
+    uint64_t books_offset;
+    uint64_t order_count;
+    uint64_t orders_offset;
+    BookStats stats;
+};
+
+struct CheckpointSymbol {
+    uint16_t stock_locate;
+    uint8_t reserved[6];
+    SymbolInfo info;
+};
+
+/**
+ * One book: its orders are the next order_count records, bids then asks,
+ * best level first and in time priority within a level
+ */
+struct CheckpointBook {
+    uint16_t stock_locate;
+    uint8_t reserved[6];
+    uint64_t timestamp;
+    uint64_t order_count;
+};
+
+struct CheckpointOrder {
+    uint64_t reference;
+    uint32_t price;
+    uint32_t shares;
+    uint16_t stock_locate;
+    uint8_t side;               // 0 = buy, 1 = sell
+    uint8_t reserved[5];
+};
+
+/**
+ * Summary of a saved or loaded checkpoint
+ */
+struct CheckpointInfo {
+    uint64_t sequence = 0;
+    size_t symbols = 0;
+    size_t books = 0;
+    size_t orders = 0;
+};
+
+/**
+ * Snapshot and warm restart of a BookManager
+ * save() writes every resting order, per-book timestamps, the symbol
+ * directory, the update counters and the caller's next sequence number
+ * into a flat file (written through a mapping, synced, then renamed into
+ * place so a crash never leaves a half-written checkpoint). load() maps
+ * it back and rebuilds the books in one pass over the order records, then
+ * the feed resumes from the stored sequence (MoldUDP64Decoder::expect, or
+ * the sequence passed to SoupBinTCPSession::login) instead of replaying
+ * the day.
+ */
+class BookCheckpoint {
+public:
+    static constexpr uint64_t MAGIC = 0x3150434B4F4F424DULL;  // "MBOOKCP1"
+    static constexpr uint32_t VERSION = 2;
+    
+    /**
+     * @param sequence Next sequence number the feed should deliver
+     * @throws std::runtime_error on I/O failure
+     */
+    static CheckpointInfo save(const BookManager& books, const std::string& path, uint64_t sequence);
+    
+    /**
+     * Replace the manager's state with a checkpoint
+     * @throws std::runtime_error if the file is missing or malformed
+     */
+    static CheckpointInfo load(BookManager& books, const std::string& path);
+};
+
+} // namespace fast_market
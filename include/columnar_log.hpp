@@ -0,0 +1,254 @@
+#pragma once
+
+#include "itch_protocol.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fast_market {
+
+/**
+ * One column of a message type: a field of the decoded struct
+ * Column 0 of every type is the timestamp, widened to uint64_t; the rest
+ * are copied as they sit in the struct (host order, char arrays as-is).
+ */
+struct ColumnSpec {
+    const char* name;
+    uint16_t offset;            // Byte offset in the decoded message struct
+    uint16_t size;              // Bytes per value in the file
+    bool integer;               // Unsigned integer; otherwise flag bytes or characters
+};
+
+struct ColumnSchema {
+    const ColumnSpec* columns = nullptr;
+    size_t count = 0;
+};
+
+/**
+ * Column layout of a message type (count 0 for unknown type bytes)
+ * timestamp, stock_locate and tracking_number come first for every type.
+ */
+[[nodiscard]] ColumnSchema columnar_schema(MessageType type) noexcept;
+
+/**
+ * Columnar file header (first 64 bytes)
+ */
+struct ColumnarFileHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t rows_per_group;
+    uint8_t reserved[48];
+};
+
+/**
+ * Footer entry: where a row group starts and what it holds
+ * The timestamp range lets scans skip whole groups.
+ */
+struct RowGroupMeta {
+    uint64_t offset;            // From the start of the file, 64-byte aligned
+    uint64_t first_timestamp;
+    uint64_t last_timestamp;
+    uint32_t rows;
+    uint8_t message_type;
+    uint8_t column_count;
+    uint8_t reserved[2];
+};
+
+/**
+ * Last 24 bytes of the file, after the footer entries
+ */
+struct ColumnarTrailer {
+    uint64_t footer_offset;
+    uint64_t row_group_count;
+    uint64_t magic;
+};
+
+/**
+ * Struct-of-arrays encoder for decoded messages
+ * Rows are buffered per message type, one contiguous block per column.
+ * When a type has rows_per_group rows its block is written out as one row
+ * group: every column's values back to back, each column chunk starting
+ * 8-byte aligned. finish() writes the partial groups and a footer listing
+ * every group, so a reader maps the file and touches only the columns it
+ * scans (a trade's price and shares are 8 of its 44 bytes).
+ *
+ * Writes go straight to the file descriptor: groups are large, so there
+ * is one write() per group. Single-threaded (the logger thread).
+ */
+class ColumnarWriter {
+public:
+    static constexpr uint64_t MAGIC = 0x314C4F4348435449ULL;  // "ITCHCOL1"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t DEFAULT_ROWS_PER_GROUP = 65536;
+    static constexpr size_t MAX_COLUMNS = 24;
+    
+    /**
+     * @param fd Open, empty file; not closed by the writer
+     * @param rows_per_group Rows per full group, a multiple of 64
+     * @throws std::invalid_argument if rows_per_group is 0 or unaligned
+     */
+    explicit ColumnarWriter(int fd, size_t rows_per_group = DEFAULT_ROWS_PER_GROUP);
+    ~ColumnarWriter();
+    
+    ColumnarWriter(const ColumnarWriter&) = delete;
+    ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+    
+    /**
+     * Buffer one message, writing its type's group out once it is full
+     */
+    void append(const ParsedMessage& msg) {
+        TypeBuffer& buffer = buffers_[static_cast<uint8_t>(msg.type)];
+        if (buffer.data == nullptr) [[unlikely]] {
+            if (!open_buffer(buffer, msg.type)) {
+                return;
+            }
+        }
+        
+        const auto* src = reinterpret_cast<const uint8_t*>(&msg.system_event);
+        const uint64_t timestamp = msg.system_event.header.timestamp.value();
+        const size_t row = buffer.rows;
+        std::memcpy(buffer.data + row * sizeof(uint64_t), &timestamp, sizeof(timestamp));
+        if (row == 0) {
+            buffer.first_timestamp = timestamp;
+        }
+        buffer.last_timestamp = timestamp;
+        
+        for (size_t i = 1; i < buffer.schema.count; ++i) {
+            const ColumnSpec& column = buffer.schema.columns[i];
+            uint8_t* dest = buffer.data + buffer.column_offsets[i] + row * column.size;
+            switch (column.size) {
+                case 1: *dest = src[column.offset]; break;
+                case 2: std::memcpy(dest, src + column.offset, 2); break;
+                case 4: std::memcpy(dest, src + column.offset, 4); break;
+                case 8: std::memcpy(dest, src + column.offset, 8); break;
+                default: std::memcpy(dest, src + column.offset, column.size); break;
+            }
+        }
+        
+        if (++buffer.rows == rows_per_group_) [[unlikely]] {
+            write_group(buffer);
+        }
+    }
+    
+    /**
+     * Write the partial groups and the footer; append() is not valid after
+     */
+    void finish();
+    
+    /**
+     * Bytes written to the file so far
+     */
+    [[nodiscard]] uint64_t bytes_written() const noexcept {
+        return file_offset_;
+    }
+    
+    [[nodiscard]] uint64_t rows_written() const noexcept {
+        return rows_written_;
+    }
+    
+    [[nodiscard]] size_t row_groups() const noexcept {
+        return footer_.size();
+    }
+    
+    /**
+     * False once a write to the file has failed
+     */
+    [[nodiscard]] bool ok() const noexcept {
+        return ok_;
+    }
+    
+private:
+    struct TypeBuffer {
+        uint8_t* data = nullptr;
+        size_t size = 0;
+        size_t rows = 0;
+        uint64_t first_timestamp = 0;
+        uint64_t last_timestamp = 0;
+        ColumnSchema schema;
+        std::array<size_t, MAX_COLUMNS> column_offsets{};
+        uint8_t message_type = 0;
+    };
+    
+    bool open_buffer(TypeBuffer& buffer, MessageType type);
+    void write_group(TypeBuffer& buffer);
+    void write_bytes(const void* data, size_t size);
+    void pad_to(uint64_t alignment);
+    
+    int fd_;
+    size_t rows_per_group_;
+    uint64_t file_offset_ = 0;
+    uint64_t rows_written_ = 0;
+    bool ok_ = true;
+    bool finished_ = false;
+    std::array<TypeBuffer, 256> buffers_{};
+    std::vector<RowGroupMeta> footer_;
+};
+
+/**
+ * Read side of a columnar log: maps the file and hands out column chunks
+ * Column pointers are aligned for their value type where the size is a
+ * power of two, so they can be read as plain arrays.
+ */
+class ColumnarLogReader {
+public:
+    /**
+     * @throws std::runtime_error if the file is missing or malformed
+     */
+    explicit ColumnarLogReader(const std::string& path);
+    ~ColumnarLogReader();
+    
+    ColumnarLogReader(const ColumnarLogReader&) = delete;
+    ColumnarLogReader& operator=(const ColumnarLogReader&) = delete;
+    
+    [[nodiscard]] size_t row_group_count() const noexcept {
+        return groups_.size();
+    }
+    
+    [[nodiscard]] const RowGroupMeta& row_group(size_t group) const noexcept {
+        return groups_[group];
+    }
+    
+    /**
+     * Index of a named column of a type, or -1 if it has none
+     */
+    [[nodiscard]] static int column_index(MessageType type, std::string_view name) noexcept;
+    
+    /**
+     * Start of one column chunk of a row group (row_group(group).rows values)
+     */
+    [[nodiscard]] const uint8_t* column(size_t group, size_t column) const noexcept {
+        return base_ + column_offset(group, column);
+    }
+    
+    template<typename T>
+    [[nodiscard]] const T* column_as(size_t group, size_t index) const noexcept {
+        return reinterpret_cast<const T*>(column(group, index));
+    }
+    
+    /**
+     * Bytes occupied by one column chunk, padding included
+     */
+    [[nodiscard]] size_t column_bytes(size_t group, size_t column) const noexcept;
+    
+    /**
+     * Rows of a type across the file
+     */
+    [[nodiscard]] uint64_t rows(MessageType type) const noexcept;
+    
+    [[nodiscard]] size_t file_size() const noexcept {
+        return size_;
+    }
+    
+private:
+    [[nodiscard]] size_t column_offset(size_t group, size_t column) const noexcept;
+    
+    const uint8_t* base_ = nullptr;
+    size_t size_ = 0;
+    std::vector<RowGroupMeta> groups_;
+};
+
+} // namespace fast_market
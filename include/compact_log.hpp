@@ -0,0 +1,377 @@
+#pragma once
+
+#include "columnar_log.hpp"
+#include "itch_protocol.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fast_market {
+
+/**
+ * How one message field is stored in a compact record
+ */
+enum class CompactField : uint8_t {
+    TIMESTAMP,      // Zigzag varint delta from the previous record of the type
+    DELTA,          // Same, for order references and match numbers
+    VARINT,         // Unsigned varint of the value
+    SYMBOL,         // 0 if it repeats the locate's last symbol, else 1 + 8 chars
+    RAW             // Bytes as-is (flags, character codes)
+};
+
+struct CompactFieldPlan {
+    uint16_t offset;            // Byte offset in the decoded message struct
+    uint8_t size;               // Field size in the struct
+    CompactField kind;
+};
+
+/**
+ * Field encodings of one message type, derived from columnar_schema()
+ */
+struct CompactPlan {
+    std::array<CompactFieldPlan, ColumnarWriter::MAX_COLUMNS> fields{};
+    size_t count = 0;           // 0 for type bytes that are not ITCH 5.0
+};
+
+/**
+ * Plans for every type byte
+ */
+[[nodiscard]] const std::array<CompactPlan, 256>& compact_plans() noexcept;
+
+/**
+ * Compact log file header (first 16 bytes)
+ */
+struct CompactLogHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t reserved;
+};
+
+/**
+ * Delta/varint encoder for decoded messages
+ * A record is the type byte followed by the message fields in struct
+ * order: the timestamp, order references and match numbers as zigzag
+ * varint deltas from the previous record of the same type, other integers
+ * as varints, flags as raw bytes. The 8-byte symbol is replaced by one
+ * byte when it repeats the last symbol seen for the record's stock_locate,
+ * which is every message after the stock directory. An add order shrinks
+ * from 36 bytes to about 16.
+ *
+ * Records only decode in order from the start of their segment. A writer
+ * that wants to seek into a file calls start_segment() at the seek points:
+ * it writes a one-byte marker and resets the state, and the decoder resets
+ * when it reads the marker.
+ */
+class CompactEncoder {
+public:
+    static constexpr uint64_t MAGIC = 0x31504D4348435449ULL;  // "ITCHCMP1"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t MAX_RECORD_SIZE = 128;
+    static constexpr size_t MAX_LOCATES = 65536;
+    static constexpr uint8_t SEGMENT_MARK = 0;  // Never an ITCH type byte
+    
+    CompactEncoder();
+    
+    /**
+     * Encode one message into out (room for MAX_RECORD_SIZE bytes)
+     * @return Bytes written, 0 for a message type that is not ITCH 5.0
+     */
+    size_t encode(const ParsedMessage& msg, uint8_t* out) noexcept {
+        const uint8_t type = static_cast<uint8_t>(msg.type);
+        const CompactPlan& plan = (*plans_)[type];
+        if (plan.count == 0) [[unlikely]] {
+            return 0;
+        }
+        
+        const auto* src = reinterpret_cast<const uint8_t*>(&msg.system_event);
+        const uint16_t locate = msg.system_event.header.stock_locate;
+        uint64_t* previous = previous_[type].data();
+        uint8_t* pos = out;
+        *pos++ = type;
+        for (size_t i = 0; i < plan.count; ++i) {
+            const CompactFieldPlan& field = plan.fields[i];
+            switch (field.kind) {
+                case CompactField::TIMESTAMP: {
+                    const uint64_t value = msg.system_event.header.timestamp.value();
+                    pos = put_varint(pos, zigzag(value - previous[i]));
+                    previous[i] = value;
+                    break;
+                }
+                case CompactField::DELTA: {
+                    const uint64_t value = load(src + field.offset, field.size);
+                    pos = put_varint(pos, zigzag(value - previous[i]));
+                    previous[i] = value;
+                    break;
+                }
+                case CompactField::VARINT:
+                    pos = put_varint(pos, load(src + field.offset, field.size));
+                    break;
+                case CompactField::SYMBOL: {
+                    KnownSymbol& known = symbols_[locate];
+                    if (known.generation == generation_ && std::memcmp(known.stock, src + field.offset, 8) == 0) {
+                        *pos++ = 0;
+                    } else {
+                        *pos++ = 1;
+                        std::memcpy(pos, src + field.offset, 8);
+                        std::memcpy(known.stock, src + field.offset, 8);
+                        known.generation = generation_;
+                        pos += 8;
+                    }
+                    break;
+                }
+                case CompactField::RAW:
+                    copy(pos, src + field.offset, field.size);
+                    pos += field.size;
+                    break;
+            }
+        }
+        return static_cast<size_t>(pos - out);
+    }
+    
+    /**
+     * Forget all delta and symbol state and write a segment marker to out
+     * @return Bytes written (1)
+     */
+    size_t start_segment(uint8_t* out) noexcept {
+        reset();
+        *out = SEGMENT_MARK;
+        return 1;
+    }
+    
+    /**
+     * Forget all delta and symbol state; the next record decodes on its own
+     * only if the decoder is reset at the same point
+     */
+    void reset() noexcept;
+    
+    static uint8_t* put_varint(uint8_t* out, uint64_t value) noexcept {
+        while (value >= 0x80) {
+            *out++ = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        *out++ = static_cast<uint8_t>(value);
+        return out;
+    }
+    
+    static constexpr uint64_t zigzag(uint64_t delta) noexcept {
+        return (delta << 1) ^ (0 - (delta >> 63));
+    }
+    
+    static constexpr uint64_t unzigzag(uint64_t value) noexcept {
+        return (value >> 1) ^ (0 - (value & 1));
+    }
+    
+    // Fields are host order (little-endian) in the decoded struct; fixed
+    // sizes keep the copies inline
+    static uint64_t load(const uint8_t* src, size_t size) noexcept {
+        switch (size) {
+            case 2: { uint16_t value; std::memcpy(&value, src, 2); return value; }
+            case 4: { uint32_t value; std::memcpy(&value, src, 4); return value; }
+            case 8: { uint64_t value; std::memcpy(&value, src, 8); return value; }
+            default: return *src;
+        }
+    }
+    
+    static void store(uint8_t* dest, uint64_t value, size_t size) noexcept {
+        switch (size) {
+            case 2: { const auto narrow = static_cast<uint16_t>(value); std::memcpy(dest, &narrow, 2); break; }
+            case 4: { const auto narrow = static_cast<uint32_t>(value); std::memcpy(dest, &narrow, 4); break; }
+            case 8: std::memcpy(dest, &value, 8); break;
+            default: *dest = static_cast<uint8_t>(value); break;
+        }
+    }
+    
+    static void copy(uint8_t* dest, const uint8_t* src, size_t size) noexcept {
+        if (size == 1) [[likely]] {
+            *dest = *src;
+        } else {
+            std::memcpy(dest, src, size);
+        }
+    }
+    
+private:
+    friend class CompactDecoder;
+    
+    struct KnownSymbol {
+        char stock[8];
+        uint32_t generation;
+    };
+    
+    const std::array<CompactPlan, 256>* plans_;
+    std::array<std::array<uint64_t, ColumnarWriter::MAX_COLUMNS>, 256> previous_{};
+    std::vector<KnownSymbol> symbols_;
+    uint32_t generation_ = 1;
+};
+
+/**
+ * Inverse of CompactEncoder, fed the same records in the same order
+ */
+class CompactDecoder {
+public:
+    CompactDecoder();
+    
+    /**
+     * Decode the record at data into out, after a segment marker if any
+     * @return Bytes consumed, 0 if the record is truncated or malformed
+     */
+    size_t decode(const uint8_t* data, size_t size, ParsedMessage& out) noexcept {
+        if (size != 0 && data[0] == CompactEncoder::SEGMENT_MARK) [[unlikely]] {
+            reset();
+            const size_t used = decode(data + 1, size - 1, out);
+            return used != 0 ? used + 1 : 0;
+        }
+        if (size == 0) [[unlikely]] {
+            return 0;
+        }
+        const uint8_t type = data[0];
+        const CompactPlan& plan = (*plans_)[type];
+        if (plan.count == 0) [[unlikely]] {
+            return 0;
+        }
+        
+        out.type = static_cast<MessageType>(type);
+        out.parse_timestamp_ns = 0;
+        auto* dest = reinterpret_cast<uint8_t*>(&out.system_event);
+        out.system_event.header.message_type = type;
+        uint64_t* previous = previous_[type].data();
+        const uint8_t* pos = data + 1;
+        const uint8_t* end = data + size;
+        for (size_t i = 0; i < plan.count; ++i) {
+            const CompactFieldPlan& field = plan.fields[i];
+            uint64_t value = 0;
+            switch (field.kind) {
+                case CompactField::TIMESTAMP:
+                    if ((pos = get_varint(pos, end, value)) == nullptr) [[unlikely]] {
+                        return 0;
+                    }
+                    value = previous[i] + CompactEncoder::unzigzag(value);
+                    previous[i] = value;
+                    out.system_event.header.timestamp.high = static_cast<uint16_t>(value >> 32);
+                    out.system_event.header.timestamp.low = static_cast<uint32_t>(value);
+                    break;
+                case CompactField::DELTA:
+                    if ((pos = get_varint(pos, end, value)) == nullptr) [[unlikely]] {
+                        return 0;
+                    }
+                    value = previous[i] + CompactEncoder::unzigzag(value);
+                    previous[i] = value;
+                    CompactEncoder::store(dest + field.offset, value, field.size);
+                    break;
+                case CompactField::VARINT:
+                    if ((pos = get_varint(pos, end, value)) == nullptr ||
+                        (field.size < 8 && value >> (field.size * 8) != 0)) [[unlikely]] {
+                        return 0;
+                    }
+                    CompactEncoder::store(dest + field.offset, value, field.size);
+                    break;
+                case CompactField::SYMBOL: {
+                    // Header fields come first, so the locate is already decoded
+                    CompactEncoder::KnownSymbol& known = symbols_[out.system_event.header.stock_locate];
+                    if (pos == end) [[unlikely]] {
+                        return 0;
+                    }
+                    if (*pos++ == 0) {
+                        if (known.generation != generation_) [[unlikely]] {
+                            return 0;
+                        }
+                    } else {
+                        if (end - pos < 8) [[unlikely]] {
+                            return 0;
+                        }
+                        std::memcpy(known.stock, pos, 8);
+                        known.generation = generation_;
+                        pos += 8;
+                    }
+                    std::memcpy(dest + field.offset, known.stock, 8);
+                    break;
+                }
+                case CompactField::RAW:
+                    if (static_cast<size_t>(end - pos) < field.size) [[unlikely]] {
+                        return 0;
+                    }
+                    CompactEncoder::copy(dest + field.offset, pos, field.size);
+                    pos += field.size;
+                    break;
+            }
+        }
+        return static_cast<size_t>(pos - data);
+    }
+    
+    void reset() noexcept;
+    
+    /**
+     * @return Position after the varint, nullptr if truncated or over 64 bits
+     */
+    static const uint8_t* get_varint(const uint8_t* pos, const uint8_t* end, uint64_t& value) noexcept {
+        value = 0;
+        for (unsigned shift = 0; pos != end && shift < 64; shift += 7) {
+            const uint8_t byte = *pos++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return pos;
+            }
+        }
+        return nullptr;
+    }
+    
+private:
+    const std::array<CompactPlan, 256>* plans_;
+    std::array<std::array<uint64_t, ColumnarWriter::MAX_COLUMNS>, 256> previous_{};
+    std::vector<CompactEncoder::KnownSymbol> symbols_;
+    uint32_t generation_ = 1;
+};
+
+/**
+ * Maps a compact log written by AsyncLogger (WriteMode::COMPACT) and
+ * decodes it back into ParsedMessages
+ */
+class CompactLogReader {
+public:
+    /**
+     * @throws std::runtime_error if the file is missing or not a compact log
+     */
+    explicit CompactLogReader(const std::string& path);
+    ~CompactLogReader();
+    
+    CompactLogReader(const CompactLogReader&) = delete;
+    CompactLogReader& operator=(const CompactLogReader&) = delete;
+    
+    /**
+     * Decode every record in order as fn(const ParsedMessage&)
+     * @return Records decoded
+     * @throws std::runtime_error on a corrupt record
+     */
+    template<typename Fn>
+    uint64_t for_each(Fn&& fn) const {
+        CompactDecoder decoder;
+        ParsedMessage msg;
+        uint64_t records = 0;
+        for (size_t offset = sizeof(CompactLogHeader); offset < size_; ++records) {
+            const size_t used = decoder.decode(base_ + offset, size_ - offset, msg);
+            if (used == 0) [[unlikely]] {
+                throw std::runtime_error("Corrupt compact log record at offset " + std::to_string(offset));
+            }
+            offset += used;
+            fn(static_cast<const ParsedMessage&>(msg));
+        }
+        return records;
+    }
+    
+    [[nodiscard]] const uint8_t* data() const noexcept {
+        return base_;
+    }
+    
+    [[nodiscard]] size_t size() const noexcept {
+        return size_;
+    }
+    
+private:
+    const uint8_t* base_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace fast_market
@@ -0,0 +1,345 @@
+#pragma once
+
+#include "system_utils.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace fast_market {
+
+/**
+ * Open-addressing map from order reference number to an order handle
+ * Robin Hood linear probing over a separate array of 1-byte tags: 0 marks
+ * an empty slot, otherwise the tag is 1 + the entry's distance from its
+ * home slot. A key can only sit where the tag equals its own probe
+ * distance, so a lookup compares 16 tags against a distance ramp in one
+ * SSE2 compare, touches the 16-byte key/value slot only on a match, and
+ * stops at the first entry closer to home than it (Robin Hood order).
+ *
+ * Erase shifts the rest of the run back one slot until an empty slot or
+ * an entry already at home (backward-shift deletion), so there are no
+ * tombstones and lookups never degrade over a session with billions of
+ * add/delete pairs.
+ *
+ * ITCH reference numbers increase through the day, so the home slot keeps
+ * them in order (a light xor-shift only breaks up strided keys): live
+ * orders sit mostly at home and neighbouring references share cache lines.
+ *
+ * Value must be trivially copyable (a pointer or pool index).
+ */
+template<typename Value>
+class FlatOrderMap {
+    static_assert(std::is_trivially_copyable_v<Value>, "Value must be trivially copyable");
+    
+public:
+    static constexpr size_t GROUP_SIZE = 16;
+    static constexpr size_t MIN_CAPACITY = 64;
+    
+    struct Slot {
+        uint64_t key;
+        Value value;
+    };
+    
+    /**
+     * @param expected Entries to size the table for without rehashing
+     */
+    explicit FlatOrderMap(size_t expected = 0) {
+        allocate(capacity_for(expected));
+    }
+    
+    ~FlatOrderMap() {
+        SystemUtils::free_large(memory_, memory_bytes_);
+    }
+    
+    FlatOrderMap(const FlatOrderMap&) = delete;
+    FlatOrderMap& operator=(const FlatOrderMap&) = delete;
+    
+    FlatOrderMap(FlatOrderMap&& other) noexcept {
+        swap(other);
+    }
+    
+    FlatOrderMap& operator=(FlatOrderMap&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+    
+    /**
+     * @return Pointer to the value, or nullptr if the key is absent
+     */
+    [[nodiscard]] Value* find(uint64_t key) noexcept {
+        const size_t index = find_index(key);
+        return index != NOT_FOUND ? &slots_[index].value : nullptr;
+    }
+    
+    [[nodiscard]] const Value* find(uint64_t key) const noexcept {
+        const size_t index = find_index(key);
+        return index != NOT_FOUND ? &slots_[index].value : nullptr;
+    }
+    
+    /**
+     * Insert a new key
+     * @return false (and no change) if the key is already present
+     */
+    bool insert(uint64_t key, Value value) {
+        if (size_ >= max_load_) [[unlikely]] {
+            rehash(capacity_ * 2);
+        }
+        if (find_index(key) != NOT_FOUND) {
+            return false;
+        }
+        place(Slot{key, value});
+        ++size_;
+        return true;
+    }
+    
+    /**
+     * Remove a key
+     * @return false if it was not present
+     */
+    bool erase(uint64_t key) noexcept {
+        const size_t index = find_index(key);
+        if (index == NOT_FOUND) {
+            return false;
+        }
+        erase_at(index);
+        return true;
+    }
+    
+    /**
+     * Remove a key and hand back its value in one probe
+     */
+    bool extract(uint64_t key, Value& value) noexcept {
+        const size_t index = find_index(key);
+        if (index == NOT_FOUND) {
+            return false;
+        }
+        value = slots_[index].value;
+        erase_at(index);
+        return true;
+    }
+    
+    /**
+     * Grow so that at least `expected` entries fit without rehashing
+     */
+    void reserve(size_t expected) {
+        const size_t capacity = capacity_for(expected);
+        if (capacity > capacity_) {
+            rehash(capacity);
+        }
+    }
+    
+    void clear() noexcept {
+        if (tags_ != nullptr) {
+            std::memset(tags_, 0, capacity_ + GROUP_SIZE);
+        }
+        size_ = 0;
+    }
+    
+    /**
+     * Visit every entry as fn(key, value)
+     */
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (tags_[i] != 0) {
+                fn(slots_[i].key, slots_[i].value);
+            }
+        }
+    }
+    
+    [[nodiscard]] size_t size() const noexcept {
+        return size_;
+    }
+    
+    [[nodiscard]] bool empty() const noexcept {
+        return size_ == 0;
+    }
+    
+    [[nodiscard]] size_t capacity() const noexcept {
+        return capacity_;
+    }
+    
+    // True if the table landed on explicitly reserved huge pages
+    [[nodiscard]] bool huge_pages() const noexcept {
+        return huge_pages_;
+    }
+    
+private:
+    static constexpr size_t NOT_FOUND = SIZE_MAX;
+    
+    // Load factor 7/8: Robin Hood keeps probe lengths short even this full,
+    // and 100M orders fit in a 2^27-slot table
+    static size_t capacity_for(size_t expected) noexcept {
+        const size_t wanted = expected + expected / 7 + 1;
+        return std::bit_ceil(wanted < MIN_CAPACITY ? MIN_CAPACITY : wanted);
+    }
+    
+    // Longest probe distance stored; a longer run grows the table instead.
+    // Keeps every tag and ramp value below 128 for the signed compares.
+    static constexpr size_t MAX_DISTANCE = 127 - 2 * GROUP_SIZE;
+    
+    [[gnu::always_inline]] size_t home_of(uint64_t key) const noexcept {
+        return (key ^ (key >> 17) ^ (key >> 37)) & mask_;
+    }
+    
+    // Bitmasks over the GROUP_SIZE slots starting at pos (the tail mirror
+    // makes them contiguous): slots whose entry has the given probe distance
+    // (same home as the key), and slots that end the search (empty, or an
+    // entry closer to its home than the key would be)
+    [[gnu::always_inline]]
+    uint32_t match_group(size_t pos, size_t distance, uint32_t& stop) const noexcept {
+#if defined(__SSE2__)
+        const __m128i ramp = _mm_setr_epi8(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+        const __m128i expected = _mm_add_epi8(ramp, _mm_set1_epi8(static_cast<char>(distance)));
+        const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tags_ + pos));
+        stop = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(expected, group)));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, expected)));
+#else
+        uint32_t matches = 0;
+        stop = 0;
+        for (size_t i = 0; i < GROUP_SIZE; ++i) {
+            const size_t expected = distance + i + 1;
+            matches |= static_cast<uint32_t>(tags_[pos + i] == expected) << i;
+            stop |= static_cast<uint32_t>(tags_[pos + i] < expected) << i;
+        }
+        return matches;
+#endif
+    }
+    
+    [[gnu::always_inline]]
+    size_t find_index(uint64_t key) const noexcept {
+        size_t pos = home_of(key);
+        for (size_t distance = 0; distance <= MAX_DISTANCE; distance += GROUP_SIZE) {
+            uint32_t stop;
+            uint32_t matches = match_group(pos, distance, stop);
+            if (stop != 0) [[likely]] {
+                matches &= (stop & -stop) - 1;
+            }
+            while (matches != 0) {
+                const size_t index = (pos + std::countr_zero(matches)) & mask_;
+                if (slots_[index].key == key) [[likely]] {
+                    return index;
+                }
+                matches &= matches - 1;
+            }
+            if (stop != 0) [[likely]] {
+                break;
+            }
+            pos = (pos + GROUP_SIZE) & mask_;
+        }
+        return NOT_FOUND;
+    }
+    
+    // The first GROUP_SIZE tags are mirrored past the end for wrapping loads
+    [[gnu::always_inline]] void set_tag(size_t index, uint8_t tag) noexcept {
+        tags_[index] = tag;
+        if (index < GROUP_SIZE) [[unlikely]] {
+            tags_[capacity_ + index] = tag;
+        }
+    }
+    
+    // Robin Hood placement of a key known to be absent: take the slot of
+    // the first entry closer to its home, and carry that entry on
+    void place(Slot entry) {
+        size_t pos = home_of(entry.key);
+        size_t distance = 0;
+        while (true) {
+            const uint8_t tag = tags_[pos];
+            if (tag == 0) {
+                set_tag(pos, static_cast<uint8_t>(distance + 1));
+                slots_[pos] = entry;
+                return;
+            }
+            if (tag < distance + 1) {
+                set_tag(pos, static_cast<uint8_t>(distance + 1));
+                std::swap(slots_[pos], entry);
+                distance = tag - 1;
+            }
+            pos = (pos + 1) & mask_;
+            if (++distance > MAX_DISTANCE) [[unlikely]] {
+                // Pathological run: grow and place the carried entry again
+                rehash(capacity_ * 2);
+                pos = home_of(entry.key);
+                distance = 0;
+            }
+        }
+    }
+    
+    // Backward-shift deletion
+    void erase_at(size_t hole) noexcept {
+        size_t next = (hole + 1) & mask_;
+        while (tags_[next] > 1) {
+            set_tag(hole, static_cast<uint8_t>(tags_[next] - 1));
+            slots_[hole] = slots_[next];
+            hole = next;
+            next = (next + 1) & mask_;
+        }
+        set_tag(hole, 0);
+        --size_;
+    }
+    
+    void allocate(size_t capacity) {
+        capacity_ = capacity;
+        mask_ = capacity - 1;
+        max_load_ = capacity - capacity / 8;
+        // Slots start on a cache line after the tags and their mirror
+        const size_t tag_bytes = (capacity + GROUP_SIZE + 63) & ~size_t{63};
+        memory_bytes_ = tag_bytes + capacity * sizeof(Slot);
+        memory_ = SystemUtils::allocate_large(memory_bytes_, &huge_pages_);
+        if (memory_ == nullptr) {
+            throw std::bad_alloc();
+        }
+        tags_ = static_cast<uint8_t*>(memory_);
+        slots_ = reinterpret_cast<Slot*>(tags_ + tag_bytes);
+        size_ = 0;
+    }
+    
+    void rehash(size_t capacity) {
+        uint8_t* old_tags = tags_;
+        Slot* old_slots = slots_;
+        const size_t old_capacity = capacity_;
+        void* old_memory = memory_;
+        const size_t old_bytes = memory_bytes_;
+        
+        allocate(capacity);
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (old_tags[i] != 0) {
+                place(old_slots[i]);
+                ++size_;
+            }
+        }
+        SystemUtils::free_large(old_memory, old_bytes);
+    }
+    
+    void swap(FlatOrderMap& other) noexcept {
+        std::swap(memory_, other.memory_);
+        std::swap(memory_bytes_, other.memory_bytes_);
+        std::swap(tags_, other.tags_);
+        std::swap(slots_, other.slots_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(mask_, other.mask_);
+        std::swap(max_load_, other.max_load_);
+        std::swap(size_, other.size_);
+        std::swap(huge_pages_, other.huge_pages_);
+    }
+    
+    void* memory_ = nullptr;
+    size_t memory_bytes_ = 0;
+    uint8_t* tags_ = nullptr;
+    Slot* slots_ = nullptr;
+    size_t capacity_ = 0;
+    size_t mask_ = 0;
+    size_t max_load_ = 0;
+    size_t size_ = 0;
+    bool huge_pages_ = false;
+};
+
+} // namespace fast_market
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "itch_protocol.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace fast_market {
+
+/**
+ * Struct-of-arrays destination for a batch of decoded headers
+ * Each column must hold at least `count` entries
+ */
+struct HeaderColumns {
+    uint8_t* message_type;
+    uint16_t* stock_locate;
+    uint16_t* tracking_number;
+    uint64_t* timestamp;  // Nanoseconds since midnight
+};
+
+/**
+ * Instruction set used by a decode kernel
+ */
+enum class SimdLevel : uint8_t {
+    SCALAR,
+    AVX2,    // 4 headers per iteration
+    AVX512   // 8 headers per iteration (AVX-512F + BW)
+};
+
+/**
+ * Vectorized ITCH header decoder
+ * Gathers the 11-byte headers of a batch of messages (offsets produced by
+ * ITCHParser::index_frames) and byte-swaps them into columns with
+ * pshufb/vpshufb. The kernel is chosen once at runtime from what the CPU
+ * supports; messages too close to the end of the buffer for a 16-byte
+ * load always go through the scalar path.
+ */
+class BatchHeaderDecoder {
+public:
+    /**
+     * Best kernel supported by the running CPU
+     */
+    [[nodiscard]] static SimdLevel best_available() noexcept;
+    
+    /**
+     * Decode `count` headers using the best available kernel
+     * @param data Buffer the offsets refer to
+     * @param length Size of the buffer, bounds the vector loads
+     * @param offsets Message start offsets, ascending
+     */
+    static void decode(const uint8_t* data, size_t length, const uint32_t* offsets,
+                       size_t count, const HeaderColumns& out) noexcept;
+    
+    /**
+     * Decode with a specific kernel (must be supported by the CPU)
+     */
+    static void decode(SimdLevel level, const uint8_t* data, size_t length,
+                       const uint32_t* offsets, size_t count, const HeaderColumns& out) noexcept;
+};
+
+} // namespace fast_market
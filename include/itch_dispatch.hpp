@@ -0,0 +1,567 @@
+#pragma once
+
+#include "itch_protocol.hpp"
+#include "itch_views.hpp"
+#include <array>
+#include <tuple>
+
+namespace fast_market {
+
+/**
+ * Wire -> host decoders, one per ITCH 5.0 message type
+ * Each type-puns the raw bytes onto the packed struct and byte-swaps
+ * every multi-byte field into the output
+ */
+
+[[gnu::always_inline]] inline void decode_header(const ITCHMessageHeader& wire, ITCHMessageHeader& out) noexcept {
+    out.message_type = wire.message_type;
+    out.stock_locate = ntoh16(wire.stock_locate);
+    out.tracking_number = ntoh16(wire.tracking_number);
+    out.timestamp = ntoh48(wire.timestamp);
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, SystemEventMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const SystemEventMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.event_code = wire_msg->event_code;
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, StockDirectoryMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const StockDirectoryMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.stock = wire_msg->stock;
+    out.market_category = wire_msg->market_category;
+    out.financial_status_indicator = wire_msg->financial_status_indicator;
+    out.round_lot_size = ntoh32(wire_msg->round_lot_size);
+    out.round_lots_only = wire_msg->round_lots_only;
+    out.issue_classification = wire_msg->issue_classification;
+    out.issue_sub_type = wire_msg->issue_sub_type;
+    out.authenticity = wire_msg->authenticity;
+    out.short_sale_threshold_indicator = wire_msg->short_sale_threshold_indicator;
+    out.ipo_flag = wire_msg->ipo_flag;
+    out.luld_reference_price_tier = wire_msg->luld_reference_price_tier;
+    out.etp_flag = wire_msg->etp_flag;
+    out.etp_leverage_factor = ntoh32(wire_msg->etp_leverage_factor);
+    out.inverse_indicator = wire_msg->inverse_indicator;
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, StockTradingActionMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const StockTradingActionMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.stock = wire_msg->stock;
+    out.trading_state = wire_msg->trading_state;
+    out.reserved = wire_msg->reserved;
+    out.reason = wire_msg->reason;
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, RegSHORestrictionMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const RegSHORestrictionMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.stock = wire_msg->stock;
+    out.reg_sho_action = wire_msg->reg_sho_action;
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, MarketParticipantPositionMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const MarketParticipantPositionMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.mpid = wire_msg->mpid;
+    out.stock = wire_msg->stock;
+    out.primary_market_maker = wire_msg->primary_market_maker;
+    out.market_maker_mode = wire_msg->market_maker_mode;
+    out.market_participant_state = wire_msg->market_participant_state;
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, MWCBDeclineLevelMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const MWCBDeclineLevelMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.level1 = ntoh64(wire_msg->level1);
+    out.level2 = ntoh64(wire_msg->level2);
+    out.level3 = ntoh64(wire_msg->level3);
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, MWCBStatusMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const MWCBStatusMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.breached_level = wire_msg->breached_level;
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, IPOQuotingPeriodMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const IPOQuotingPeriodMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.stock = wire_msg->stock;
+    out.ipo_quotation_release_time = ntoh32(wire_msg->ipo_quotation_release_time);
+    out.ipo_quotation_release_qualifier = wire_msg->ipo_quotation_release_qualifier;
+    out.ipo_price = ntoh32(wire_msg->ipo_price);
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, LULDAuctionCollarMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const LULDAuctionCollarMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.stock = wire_msg->stock;
+    out.auction_collar_reference_price = ntoh32(wire_msg->auction_collar_reference_price);
+    out.upper_auction_collar_price = ntoh32(wire_msg->upper_auction_collar_price);
+    out.lower_auction_collar_price = ntoh32(wire_msg->lower_auction_collar_price);
+    out.auction_collar_extension = ntoh32(wire_msg->auction_collar_extension);
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, OperationalHaltMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const OperationalHaltMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.stock = wire_msg->stock;
+    out.market_code = wire_msg->market_code;
+    out.operational_halt_action = wire_msg->operational_halt_action;
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, AddOrderMessage& out) noexcept {
+    // Type pun: reinterpret raw bytes as struct
+    const auto* wire_msg = reinterpret_cast<const AddOrderMessage*>(data);
+    
+    // Convert from big-endian to host byte order
+    decode_header(wire_msg->header, out.header);
+    out.order_reference_number = ntoh64(wire_msg->order_reference_number);
+    out.buy_sell_indicator = wire_msg->buy_sell_indicator;
+    out.shares = ntoh32(wire_msg->shares);
+    out.stock = wire_msg->stock;
+    out.price = ntoh32(wire_msg->price);
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, AddOrderMPIDMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const AddOrderMPIDMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.order_reference_number = ntoh64(wire_msg->order_reference_number);
+    out.buy_sell_indicator = wire_msg->buy_sell_indicator;
+    out.shares = ntoh32(wire_msg->shares);
+    out.stock = wire_msg->stock;
+    out.price = ntoh32(wire_msg->price);
+    out.attribution = wire_msg->attribution;
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, ExecuteOrderMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const ExecuteOrderMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.order_reference_number = ntoh64(wire_msg->order_reference_number);
+    out.executed_shares = ntoh32(wire_msg->executed_shares);
+    out.match_number = ntoh64(wire_msg->match_number);
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, ExecuteOrderWithPriceMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const ExecuteOrderWithPriceMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.order_reference_number = ntoh64(wire_msg->order_reference_number);
+    out.executed_shares = ntoh32(wire_msg->executed_shares);
+    out.match_number = ntoh64(wire_msg->match_number);
+    out.printable = wire_msg->printable;
+    out.execution_price = ntoh32(wire_msg->execution_price);
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, OrderCancelMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const OrderCancelMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.order_reference_number = ntoh64(wire_msg->order_reference_number);
+    out.cancelled_shares = ntoh32(wire_msg->cancelled_shares);
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, OrderDeleteMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const OrderDeleteMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.order_reference_number = ntoh64(wire_msg->order_reference_number);
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, OrderReplaceMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const OrderReplaceMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.original_order_reference_number = ntoh64(wire_msg->original_order_reference_number);
+    out.new_order_reference_number = ntoh64(wire_msg->new_order_reference_number);
+    out.shares = ntoh32(wire_msg->shares);
+    out.price = ntoh32(wire_msg->price);
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, TradeMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const TradeMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.order_reference_number = ntoh64(wire_msg->order_reference_number);
+    out.buy_sell_indicator = wire_msg->buy_sell_indicator;
+    out.shares = ntoh32(wire_msg->shares);
+    out.stock = wire_msg->stock;
+    out.price = ntoh32(wire_msg->price);
+    out.match_number = ntoh64(wire_msg->match_number);
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, CrossTradeMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const CrossTradeMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.shares = ntoh64(wire_msg->shares);
+    out.stock = wire_msg->stock;
+    out.cross_price = ntoh32(wire_msg->cross_price);
+    out.match_number = ntoh64(wire_msg->match_number);
+    out.cross_type = wire_msg->cross_type;
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, BrokenTradeMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const BrokenTradeMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.match_number = ntoh64(wire_msg->match_number);
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, NOIIMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const NOIIMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.paired_shares = ntoh64(wire_msg->paired_shares);
+    out.imbalance_shares = ntoh64(wire_msg->imbalance_shares);
+    out.imbalance_direction = wire_msg->imbalance_direction;
+    out.stock = wire_msg->stock;
+    out.far_price = ntoh32(wire_msg->far_price);
+    out.near_price = ntoh32(wire_msg->near_price);
+    out.current_reference_price = ntoh32(wire_msg->current_reference_price);
+    out.cross_type = wire_msg->cross_type;
+    out.price_variation_indicator = wire_msg->price_variation_indicator;
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, RPIIMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const RPIIMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.stock = wire_msg->stock;
+    out.interest_flag = wire_msg->interest_flag;
+}
+
+[[gnu::always_inline]] inline void decode_message(const uint8_t* data, DLCRPriceDiscoveryMessage& out) noexcept {
+    const auto* wire_msg = reinterpret_cast<const DLCRPriceDiscoveryMessage*>(data);
+    
+    decode_header(wire_msg->header, out.header);
+    out.stock = wire_msg->stock;
+    out.open_eligibility_status = wire_msg->open_eligibility_status;
+    out.minimum_allowable_price = ntoh32(wire_msg->minimum_allowable_price);
+    out.maximum_allowable_price = ntoh32(wire_msg->maximum_allowable_price);
+    out.near_execution_price = ntoh32(wire_msg->near_execution_price);
+    out.near_execution_time = ntoh64(wire_msg->near_execution_time);
+    out.lower_price_range_collar = ntoh32(wire_msg->lower_price_range_collar);
+    out.upper_price_range_collar = ntoh32(wire_msg->upper_price_range_collar);
+}
+
+/**
+ * Materialize a whole host-order struct from a view
+ */
+template<typename Msg>
+[[gnu::always_inline]] inline Msg decode_message(const MessageView<Msg>& view) noexcept {
+    Msg msg;
+    decode_message(view.data(), msg);
+    return msg;
+}
+
+/**
+ * Per-message metadata used to generate the dispatch tables:
+ * the lazy view type, the type byte, the ParsedMessage union member,
+ * and the handler callback
+ */
+template<typename Msg>
+struct MessageTraits;
+
+template<> struct MessageTraits<SystemEventMessage> {
+    using View = SystemEventView;
+    static constexpr MessageType type = MessageType::SYSTEM_EVENT;
+    static constexpr auto member = &ParsedMessage::system_event;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_system_event(m)) { return h.on_system_event(m); }
+};
+
+template<> struct MessageTraits<StockDirectoryMessage> {
+    using View = StockDirectoryView;
+    static constexpr MessageType type = MessageType::STOCK_DIRECTORY;
+    static constexpr auto member = &ParsedMessage::stock_directory;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_stock_directory(m)) { return h.on_stock_directory(m); }
+};
+
+template<> struct MessageTraits<StockTradingActionMessage> {
+    using View = StockTradingActionView;
+    static constexpr MessageType type = MessageType::STOCK_TRADING_ACTION;
+    static constexpr auto member = &ParsedMessage::stock_trading_action;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_stock_trading_action(m)) { return h.on_stock_trading_action(m); }
+};
+
+template<> struct MessageTraits<RegSHORestrictionMessage> {
+    using View = RegSHORestrictionView;
+    static constexpr MessageType type = MessageType::REG_SHO_RESTRICTION;
+    static constexpr auto member = &ParsedMessage::reg_sho_restriction;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_reg_sho_restriction(m)) { return h.on_reg_sho_restriction(m); }
+};
+
+template<> struct MessageTraits<MarketParticipantPositionMessage> {
+    using View = MarketParticipantPositionView;
+    static constexpr MessageType type = MessageType::MARKET_PARTICIPANT_POSITION;
+    static constexpr auto member = &ParsedMessage::market_participant_position;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_market_participant_position(m)) { return h.on_market_participant_position(m); }
+};
+
+template<> struct MessageTraits<MWCBDeclineLevelMessage> {
+    using View = MWCBDeclineLevelView;
+    static constexpr MessageType type = MessageType::MWCB_DECLINE_LEVEL;
+    static constexpr auto member = &ParsedMessage::mwcb_decline_level;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_mwcb_decline_level(m)) { return h.on_mwcb_decline_level(m); }
+};
+
+template<> struct MessageTraits<MWCBStatusMessage> {
+    using View = MWCBStatusView;
+    static constexpr MessageType type = MessageType::MWCB_STATUS;
+    static constexpr auto member = &ParsedMessage::mwcb_status;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_mwcb_status(m)) { return h.on_mwcb_status(m); }
+};
+
+template<> struct MessageTraits<IPOQuotingPeriodMessage> {
+    using View = IPOQuotingPeriodView;
+    static constexpr MessageType type = MessageType::IPO_QUOTING_PERIOD;
+    static constexpr auto member = &ParsedMessage::ipo_quoting_period;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_ipo_quoting_period(m)) { return h.on_ipo_quoting_period(m); }
+};
+
+template<> struct MessageTraits<LULDAuctionCollarMessage> {
+    using View = LULDAuctionCollarView;
+    static constexpr MessageType type = MessageType::LULD_AUCTION_COLLAR;
+    static constexpr auto member = &ParsedMessage::luld_auction_collar;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_luld_auction_collar(m)) { return h.on_luld_auction_collar(m); }
+};
+
+template<> struct MessageTraits<OperationalHaltMessage> {
+    using View = OperationalHaltView;
+    static constexpr MessageType type = MessageType::OPERATIONAL_HALT;
+    static constexpr auto member = &ParsedMessage::operational_halt;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_operational_halt(m)) { return h.on_operational_halt(m); }
+};
+
+template<> struct MessageTraits<AddOrderMessage> {
+    using View = AddOrderView;
+    static constexpr MessageType type = MessageType::ADD_ORDER;
+    static constexpr auto member = &ParsedMessage::add_order;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_add_order(m)) { return h.on_add_order(m); }
+};
+
+template<> struct MessageTraits<AddOrderMPIDMessage> {
+    using View = AddOrderMPIDView;
+    static constexpr MessageType type = MessageType::ADD_ORDER_MPID;
+    static constexpr auto member = &ParsedMessage::add_order_mpid;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_add_order_mpid(m)) { return h.on_add_order_mpid(m); }
+};
+
+template<> struct MessageTraits<ExecuteOrderMessage> {
+    using View = ExecuteOrderView;
+    static constexpr MessageType type = MessageType::EXECUTE_ORDER;
+    static constexpr auto member = &ParsedMessage::execute_order;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_execute_order(m)) { return h.on_execute_order(m); }
+};
+
+template<> struct MessageTraits<ExecuteOrderWithPriceMessage> {
+    using View = ExecuteOrderWithPriceView;
+    static constexpr MessageType type = MessageType::EXECUTE_ORDER_WITH_PRICE;
+    static constexpr auto member = &ParsedMessage::execute_with_price;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_execute_with_price(m)) { return h.on_execute_with_price(m); }
+};
+
+template<> struct MessageTraits<OrderCancelMessage> {
+    using View = OrderCancelView;
+    static constexpr MessageType type = MessageType::ORDER_CANCEL;
+    static constexpr auto member = &ParsedMessage::order_cancel;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_order_cancel(m)) { return h.on_order_cancel(m); }
+};
+
+template<> struct MessageTraits<OrderDeleteMessage> {
+    using View = OrderDeleteView;
+    static constexpr MessageType type = MessageType::ORDER_DELETE;
+    static constexpr auto member = &ParsedMessage::order_delete;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_order_delete(m)) { return h.on_order_delete(m); }
+};
+
+template<> struct MessageTraits<OrderReplaceMessage> {
+    using View = OrderReplaceView;
+    static constexpr MessageType type = MessageType::ORDER_REPLACE;
+    static constexpr auto member = &ParsedMessage::order_replace;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_order_replace(m)) { return h.on_order_replace(m); }
+};
+
+template<> struct MessageTraits<TradeMessage> {
+    using View = TradeView;
+    static constexpr MessageType type = MessageType::TRADE;
+    static constexpr auto member = &ParsedMessage::trade;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_trade(m)) { return h.on_trade(m); }
+};
+
+template<> struct MessageTraits<CrossTradeMessage> {
+    using View = CrossTradeView;
+    static constexpr MessageType type = MessageType::CROSS_TRADE;
+    static constexpr auto member = &ParsedMessage::cross_trade;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_cross_trade(m)) { return h.on_cross_trade(m); }
+};
+
+template<> struct MessageTraits<BrokenTradeMessage> {
+    using View = BrokenTradeView;
+    static constexpr MessageType type = MessageType::BROKEN_TRADE;
+    static constexpr auto member = &ParsedMessage::broken_trade;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_broken_trade(m)) { return h.on_broken_trade(m); }
+};
+
+template<> struct MessageTraits<NOIIMessage> {
+    using View = NOIIView;
+    static constexpr MessageType type = MessageType::NOII;
+    static constexpr auto member = &ParsedMessage::noii;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_noii(m)) { return h.on_noii(m); }
+};
+
+template<> struct MessageTraits<RPIIMessage> {
+    using View = RPIIView;
+    static constexpr MessageType type = MessageType::RPII;
+    static constexpr auto member = &ParsedMessage::rpii;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_rpii(m)) { return h.on_rpii(m); }
+};
+
+template<> struct MessageTraits<DLCRPriceDiscoveryMessage> {
+    using View = DLCRPriceDiscoveryView;
+    static constexpr MessageType type = MessageType::DLCR_PRICE_DISCOVERY;
+    static constexpr auto member = &ParsedMessage::dlcr_price_discovery;
+    template<typename H> static auto deliver(H& h, const View& m) -> decltype(h.on_dlcr_price_discovery(m)) { return h.on_dlcr_price_discovery(m); }
+};
+
+/**
+ * Every message type in ITCH 5.0
+ */
+using ITCHMessageTypes = std::tuple<
+    SystemEventMessage, StockDirectoryMessage, StockTradingActionMessage,
+    RegSHORestrictionMessage, MarketParticipantPositionMessage, MWCBDeclineLevelMessage,
+    MWCBStatusMessage, IPOQuotingPeriodMessage, LULDAuctionCollarMessage,
+    OperationalHaltMessage, AddOrderMessage, AddOrderMPIDMessage,
+    ExecuteOrderMessage, ExecuteOrderWithPriceMessage, OrderCancelMessage,
+    OrderDeleteMessage, OrderReplaceMessage, TradeMessage,
+    CrossTradeMessage, BrokenTradeMessage, NOIIMessage,
+    RPIIMessage, DLCRPriceDiscoveryMessage
+>;
+
+/**
+ * True if Handler has a callback for Msg
+ */
+template<typename Msg, typename Handler>
+inline constexpr bool handles_message = requires(Handler& h, const typename MessageTraits<Msg>::View& v) {
+    MessageTraits<Msg>::deliver(h, v);
+};
+
+/**
+ * Compile-time set of subscribed message types
+ * A parser built on a subscription skips every other type with the same
+ * table lookup that validates the length, without decoding it
+ */
+template<MessageType... Types>
+struct MessageTypeSet {
+    static constexpr std::array<bool, 256> mask = [] {
+        std::array<bool, 256> m{};
+        ((m[static_cast<uint8_t>(Types)] = true), ...);
+        return m;
+    }();
+    
+    static constexpr bool contains(MessageType type) noexcept {
+        return mask[static_cast<uint8_t>(type)];
+    }
+};
+
+/**
+ * Subscription covering every ITCH 5.0 type
+ */
+using AllMessageTypes = MessageTypeSet<
+    MessageType::SYSTEM_EVENT, MessageType::STOCK_DIRECTORY, MessageType::STOCK_TRADING_ACTION,
+    MessageType::REG_SHO_RESTRICTION, MessageType::MARKET_PARTICIPANT_POSITION,
+    MessageType::MWCB_DECLINE_LEVEL, MessageType::MWCB_STATUS, MessageType::IPO_QUOTING_PERIOD,
+    MessageType::LULD_AUCTION_COLLAR, MessageType::OPERATIONAL_HALT, MessageType::ADD_ORDER,
+    MessageType::ADD_ORDER_MPID, MessageType::EXECUTE_ORDER, MessageType::EXECUTE_ORDER_WITH_PRICE,
+    MessageType::ORDER_CANCEL, MessageType::ORDER_DELETE, MessageType::ORDER_REPLACE,
+    MessageType::TRADE, MessageType::CROSS_TRADE, MessageType::BROKEN_TRADE,
+    MessageType::NOII, MessageType::RPII, MessageType::DLCR_PRICE_DISCOVERY
+>;
+
+/**
+ * ParsedMessage dispatch: 256-entry table indexed by the type byte
+ * Replaces the per-type branch chain with one load and one indirect call
+ * Unsubscribed types keep their length (so they still validate) but have
+ * no decoder
+ */
+struct DispatchEntry {
+    uint8_t length = 0;  // Expected wire length, 0 if not an ITCH 5.0 type
+    void (*decode)(const uint8_t*, ParsedMessage&) noexcept = nullptr;
+};
+
+template<typename Msg>
+void decode_into(const uint8_t* data, ParsedMessage& msg) noexcept {
+    decode_message(data, msg.*MessageTraits<Msg>::member);
+}
+
+template<typename Subscription, typename... Msgs>
+constexpr std::array<DispatchEntry, 256> make_dispatch_table(std::tuple<Msgs...>*) {
+    std::array<DispatchEntry, 256> table{};
+    ((table[static_cast<uint8_t>(MessageTraits<Msgs>::type)] = DispatchEntry{
+        static_cast<uint8_t>(sizeof(Msgs)),
+        Subscription::contains(MessageTraits<Msgs>::type) ? &decode_into<Msgs> : nullptr}), ...);
+    return table;
+}
+
+template<typename Subscription = AllMessageTypes>
+inline constexpr std::array<DispatchEntry, 256> DISPATCH_TABLE =
+    make_dispatch_table<Subscription>(static_cast<ITCHMessageTypes*>(nullptr));
+
+/**
+ * Handler dispatch: one table per handler type and subscription, holding
+ * a thunk that wraps the wire bytes in the type's view and calls the
+ * handler for each subscribed type the handler implements, and nullptr
+ * otherwise
+ */
+template<typename Handler>
+using HandlerThunk = void (*)(const uint8_t*, Handler&);
+
+template<typename Handler>
+struct HandlerEntry {
+    uint8_t length = 0;  // Expected wire length, 0 if not an ITCH 5.0 type
+    HandlerThunk<Handler> deliver = nullptr;
+};
+
+template<typename Msg, typename Handler>
+void deliver_message(const uint8_t* data, Handler& handler) {
+    const typename MessageTraits<Msg>::View view(data);
+    MessageTraits<Msg>::deliver(handler, view);
+}
+
+template<typename Msg, typename Handler>
+constexpr HandlerThunk<Handler> handler_thunk() {
+    if constexpr (handles_message<Msg, Handler>) {
+        return &deliver_message<Msg, Handler>;
+    } else {
+        return nullptr;
+    }
+}
+
+template<typename Handler, typename Subscription, typename... Msgs>
+constexpr std::array<HandlerEntry<Handler>, 256> make_handler_table(std::tuple<Msgs...>*) {
+    std::array<HandlerEntry<Handler>, 256> table{};
+    ((table[static_cast<uint8_t>(MessageTraits<Msgs>::type)] = HandlerEntry<Handler>{
+        static_cast<uint8_t>(sizeof(Msgs)),
+        Subscription::contains(MessageTraits<Msgs>::type) ? handler_thunk<Msgs, Handler>() : nullptr}), ...);
+    return table;
+}
+
+template<typename Handler, typename Subscription = AllMessageTypes>
+inline constexpr std::array<HandlerEntry<Handler>, 256> HANDLER_TABLE =
+    make_handler_table<Handler, Subscription>(static_cast<ITCHMessageTypes*>(nullptr));
+
+} // namespace fast_market
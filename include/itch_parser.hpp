@@ -1,103 +1,259 @@
 #pragma once
 
 #include "itch_protocol.hpp"
+#include "itch_dispatch.hpp"
+#include "symbol_filter.hpp"
 #include <cstring>
 #include <optional>
+#include <array>
+#include <algorithm>
+#include <type_traits>
 #include <immintrin.h>  // For SIMD intrinsics
 
 namespace fast_market {
 
+/**
+ * Result of walking a length-prefixed buffer
+ */
+struct BatchResult {
+    size_t bytes_consumed = 0;    // Bytes covered by complete frames
+    size_t messages_parsed = 0;   // Frames decoded and delivered to the handler
+    size_t messages_skipped = 0;  // Complete frames that failed to parse
+    size_t messages_filtered = 0; // Well-formed frames not delivered (unsubscribed
+                                  // type or symbol, or no handler callback)
+};
+
+/**
+ * How ParsedMessage::parse_timestamp_ns is filled
+ */
+enum class TimestampMode : uint8_t {
+    NONE,         // Left at 0; no rdtsc (offline backfills)
+    PER_BATCH,    // One rdtsc per parse_batch/parse_stream call, shared by its messages
+    PER_MESSAGE   // One rdtsc per message
+};
+
 /**
  * Zero-Copy ITCH Parser
  * Uses type punning to directly map wire format to structs
  * No heap allocations, minimal branching
+ * @tparam Subscription MessageTypeSet of types to decode; everything else
+ *         is validated and skipped without being decoded, e.g.
+ *   using OrderFlowParser = BasicITCHParser<MessageTypeSet<
+ *       MessageType::ADD_ORDER, MessageType::ORDER_DELETE, ...>>;
+ * An optional SymbolFilter additionally drops messages by stock_locate
+ * before decoding
+ * @tparam Timestamps Receive-time stamping policy; handler callbacks get
+ *         views and are never stamped
  */
-class ITCHParser {
+template<typename Subscription = AllMessageTypes, TimestampMode Timestamps = TimestampMode::PER_MESSAGE>
+class BasicITCHParser {
 public:
-    ITCHParser() = default;
-    ~ITCHParser() = default;
+    // Every message in NASDAQ files and MoldUDP64 payloads is preceded by
+    // a 2-byte big-endian length
+    static constexpr size_t FRAME_PREFIX_SIZE = 2;
+    static constexpr size_t MAX_FRAME_SIZE = FRAME_PREFIX_SIZE + UINT16_MAX;
+    
+    // How far ahead of the current frame to prefetch (a few messages)
+    static constexpr size_t PREFETCH_DISTANCE = 256;
+    
+    BasicITCHParser() = default;
+    ~BasicITCHParser() = default;
+    
+    /**
+     * True if this parser decodes and delivers messages of the given type
+     */
+    static constexpr bool subscribes(MessageType type) noexcept {
+        return Subscription::contains(type);
+    }
+    
+    /**
+     * Attach a per-symbol filter (nullptr to disable)
+     * The filter learns locates from stock directory messages as they are
+     * parsed, so attach it before the start-of-day directory is replayed
+     * The parser does not own the filter
+     */
+    void set_symbol_filter(SymbolFilter* filter) noexcept {
+        filter_ = filter;
+    }
+    
+    [[nodiscard]] SymbolFilter* symbol_filter() const noexcept {
+        return filter_;
+    }
     
     /**
      * Parse a message from raw bytes
+     * Decodes every field into a self-contained copy; prefer the handler
+     * overload when the consumer reads only a few fields
      * @param data Pointer to message start
      * @param length Length of message in bytes
-     * @return Parsed message if valid, nullopt otherwise
+     * @return Parsed message if valid and subscribed, nullopt otherwise
      */
     [[nodiscard]] std::optional<ParsedMessage> parse(const uint8_t* data, size_t length) noexcept {
         if (length < sizeof(ITCHMessageHeader)) [[unlikely]] {
             return std::nullopt;
         }
         
-        ParsedMessage msg;
-        msg.type = static_cast<MessageType>(data[0]);
+        const DispatchEntry& entry = DISPATCH_TABLE<Subscription>[data[0]];
+        if (length != entry.length) [[unlikely]] {
+            return std::nullopt;
+        }
+        if (!passes_filter(data) || entry.decode == nullptr) {
+            return std::nullopt;
+        }
         
-        // Use branch hints based on ITCH message frequency
-        // Add Order (A) is the most common message type (~40% of all messages)
-        if (msg.type == MessageType::ADD_ORDER) [[likely]] {
-            if (length != sizeof(AddOrderMessage)) [[unlikely]] {
-                return std::nullopt;
+        stamp_batch();  // A single message is its own batch
+        return build_message(entry, data);
+    }
+    
+    /**
+     * Parse a message and hand it to a typed handler callback
+     * The handler implements only the callbacks it cares about, e.g.
+     *   void on_add_order(const AddOrderView&);
+     *   void on_execute_order(const ExecuteOrderView&);
+     * (see MessageTraits for the callback name of each type) and the call
+     * is compiled into a per-handler dispatch table, without building a
+     * ParsedMessage or copying it through std::optional
+     * Views point at the caller's buffer and byte-swap only the fields read
+     * @return true if the message was well-formed (whether or not handled)
+     */
+    template<typename Handler>
+    bool parse(const uint8_t* data, size_t length, Handler& handler) noexcept {
+        stamp_batch();
+        return deliver_frame(data, length, handler) != FrameStatus::INVALID;
+    }
+    
+    /**
+     * Parse every complete length-prefixed frame in a self-contained buffer
+     * Stops at the first incomplete frame; the caller owns the remainder
+     * @param data Pointer to the first length prefix
+     * @param length Bytes available
+     * @param handler Callable invoked as handler(const ParsedMessage&),
+     *                or an on_* handler as accepted by parse(data, length, handler)
+     */
+    template<typename Handler>
+    BatchResult parse_batch(const uint8_t* data, size_t length, Handler&& handler) noexcept {
+        stamp_batch();
+        return walk_frames(data, length, handler);
+    }
+    
+    /**
+     * Parse a chunk of a continuous length-prefixed stream
+     * Frames split across chunk boundaries are carried over to the next call,
+     * so callers can feed arbitrary read()/recv() sized pieces
+     * @return Stats for this chunk; bytes_consumed is always the full length
+     */
+    template<typename Handler>
+    BatchResult parse_stream(const uint8_t* data, size_t length, Handler&& handler) noexcept {
+        BatchResult result;
+        result.bytes_consumed = length;
+        stamp_batch();
+        
+        // Finish the frame left over from the previous chunk first
+        while (carry_size_ > 0) {
+            const size_t target = pending_frame_size();
+            const size_t take = std::min(target - carry_size_, length);
+            
+            std::memcpy(carry_.data() + carry_size_, data, take);
+            carry_size_ += take;
+            data += take;
+            length -= take;
+            
+            if (carry_size_ < target) {
+                return result;  // Chunk exhausted, still incomplete
+            }
+            
+            if (carry_size_ == pending_frame_size()) {
+                const size_t msg_len = carry_size_ - FRAME_PREFIX_SIZE;
+                count_frame(result, dispatch_frame(carry_.data() + FRAME_PREFIX_SIZE, msg_len, handler));
+                carry_size_ = 0;
             }
-            return parse_add_order(data, msg);
         }
         
-        // Execute Order (E) is second most common (~25%)
-        if (msg.type == MessageType::EXECUTE_ORDER) [[likely]] {
-            if (length != sizeof(ExecuteOrderMessage)) [[unlikely]] {
-                return std::nullopt;
-            }
-            return parse_execute_order(data, msg);
+        BatchResult batch = walk_frames(data, length, handler);
+        result.messages_parsed += batch.messages_parsed;
+        result.messages_skipped += batch.messages_skipped;
+        result.messages_filtered += batch.messages_filtered;
+        
+        // Stash the trailing partial frame
+        carry_size_ = length - batch.bytes_consumed;
+        if (carry_size_ > 0) {
+            std::memcpy(carry_.data(), data + batch.bytes_consumed, carry_size_);
         }
         
-        // Other message types (less common)
-        switch (msg.type) {
-            case MessageType::EXECUTE_ORDER_WITH_PRICE:
-                if (length == sizeof(ExecuteOrderWithPriceMessage)) [[likely]] {
-                    return parse_execute_with_price(data, msg);
-                }
-                break;
-                
-            case MessageType::ORDER_CANCEL:
-                if (length == sizeof(OrderCancelMessage)) [[likely]] {
-                    return parse_order_cancel(data, msg);
-                }
-                break;
-                
-            case MessageType::ORDER_DELETE:
-                if (length == sizeof(OrderDeleteMessage)) [[likely]] {
-                    return parse_order_delete(data, msg);
-                }
-                break;
-                
-            case MessageType::ORDER_REPLACE:
-                if (length == sizeof(OrderReplaceMessage)) [[likely]] {
-                    return parse_order_replace(data, msg);
-                }
-                break;
-                
-            case MessageType::TRADE:
-                if (length == sizeof(TradeMessage)) [[likely]] {
-                    return parse_trade(data, msg);
-                }
-                break;
-                
-            case MessageType::SYSTEM_EVENT:
-                if (length == sizeof(SystemEventMessage)) [[likely]] {
-                    return parse_system_event(data, msg);
-                }
-                break;
-                
-            case MessageType::STOCK_DIRECTORY:
-                if (length == sizeof(StockDirectoryMessage)) [[likely]] {
-                    return parse_stock_directory(data, msg);
-                }
+        return result;
+    }
+    
+    /**
+     * Batch interface for session protocols whose framing differs from the
+     * 2-byte prefix (e.g. SoupBinTCP interleaves control packets): call
+     * begin_batch() once, then parse_batch_message() for each message
+     */
+    void begin_batch() noexcept {
+        stamp_batch();
+    }
+    
+    template<typename Handler>
+    void parse_batch_message(const uint8_t* data, size_t length, Handler& handler, BatchResult& result) noexcept {
+        count_frame(result, dispatch_frame(data, length, handler));
+    }
+    
+    /**
+     * Record where each complete frame's message starts, without decoding
+     * Feeds batch kernels such as BatchHeaderDecoder
+     * @param offsets Receives message offsets (past the length prefix)
+     * @param max_frames Capacity of offsets
+     * @param bytes_consumed Set to the bytes covered by the indexed frames
+     * @return Number of offsets written
+     */
+    static size_t index_frames(const uint8_t* data, size_t length, uint32_t* offsets,
+                               size_t max_frames, size_t& bytes_consumed) noexcept {
+        size_t offset = 0;
+        size_t count = 0;
+        
+        while (count < max_frames && offset + FRAME_PREFIX_SIZE <= length) {
+            const size_t frame_len = FRAME_PREFIX_SIZE + read_frame_length(data + offset);
+            if (offset + frame_len > length) [[unlikely]] {
                 break;
-                
-            default:
-                // Unknown or unsupported message type
-                return std::nullopt;
+            }
+            
+            offsets[count++] = static_cast<uint32_t>(offset + FRAME_PREFIX_SIZE);
+            offset += frame_len;
         }
         
-        return std::nullopt;
+        bytes_consumed = offset;
+        return count;
+    }
+    
+    /**
+     * Discard any partial frame carried between parse_stream calls
+     */
+    void reset_stream() noexcept {
+        carry_size_ = 0;
+    }
+    
+    /**
+     * Bytes of an incomplete frame waiting for the next parse_stream call
+     */
+    [[nodiscard]] size_t pending_bytes() const noexcept {
+        return carry_size_;
+    }
+    
+    /**
+     * Receive time of the batch being delivered under TimestampMode::PER_BATCH
+     * (0 in the other modes). Handler callbacks get views without a
+     * parse_timestamp_ns, so they read it here; valid until the next call
+     */
+    [[nodiscard]] uint64_t batch_timestamp() const noexcept {
+        return batch_timestamp_;
+    }
+    
+    /**
+     * Read the 2-byte big-endian length prefix of a frame
+     */
+    [[gnu::always_inline]] static inline size_t read_frame_length(const uint8_t* frame) noexcept {
+        uint16_t len;
+        std::memcpy(&len, frame, sizeof(len));
+        return ntoh16(len);
     }
     
     /**
@@ -109,179 +265,141 @@ public:
         __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
         return (static_cast<uint64_t>(hi) << 32) | lo;
     }
-
-private:
-    // Zero-copy parsing using type punning
-    // We directly cast the memory, relying on packed structs
     
-    [[gnu::always_inline]] 
-    std::optional<ParsedMessage> parse_add_order(const uint8_t* data, ParsedMessage& msg) noexcept {
-        // Type pun: reinterpret raw bytes as struct
-        const auto* wire_msg = reinterpret_cast<const AddOrderMessage*>(data);
-        
-        // Convert from big-endian to host byte order
-        msg.add_order.header.message_type = wire_msg->header.message_type;
-        msg.add_order.header.stock_locate = ntoh16(wire_msg->header.stock_locate);
-        msg.add_order.header.tracking_number = ntoh16(wire_msg->header.tracking_number);
-        msg.add_order.header.timestamp = ntoh64(wire_msg->header.timestamp);
-        
-        msg.add_order.order_reference_number = ntoh64(wire_msg->order_reference_number);
-        msg.add_order.buy_sell_indicator = wire_msg->buy_sell_indicator;
-        msg.add_order.shares = ntoh32(wire_msg->shares);
-        msg.add_order.stock = wire_msg->stock;
-        msg.add_order.price = ntoh32(wire_msg->price);
-        
-        msg.parse_timestamp_ns = get_timestamp_ns();
-        return msg;
+private:
+    // Size of the carried frame once its prefix is known, else of the prefix
+    [[nodiscard]] size_t pending_frame_size() const noexcept {
+        if (carry_size_ < FRAME_PREFIX_SIZE) {
+            return FRAME_PREFIX_SIZE;
+        }
+        return FRAME_PREFIX_SIZE + read_frame_length(carry_.data());
     }
     
-    [[gnu::always_inline]]
-    std::optional<ParsedMessage> parse_execute_order(const uint8_t* data, ParsedMessage& msg) noexcept {
-        const auto* wire_msg = reinterpret_cast<const ExecuteOrderMessage*>(data);
-        
-        msg.execute_order.header.message_type = wire_msg->header.message_type;
-        msg.execute_order.header.stock_locate = ntoh16(wire_msg->header.stock_locate);
-        msg.execute_order.header.tracking_number = ntoh16(wire_msg->header.tracking_number);
-        msg.execute_order.header.timestamp = ntoh64(wire_msg->header.timestamp);
-        
-        msg.execute_order.order_reference_number = ntoh64(wire_msg->order_reference_number);
-        msg.execute_order.executed_shares = ntoh32(wire_msg->executed_shares);
-        msg.execute_order.match_number = ntoh64(wire_msg->match_number);
-        
-        msg.parse_timestamp_ns = get_timestamp_ns();
-        return msg;
-    }
+    // Partial frame spanning two parse_stream chunks
+    std::array<uint8_t, MAX_FRAME_SIZE> carry_;
+    size_t carry_size_ = 0;
     
-    [[gnu::always_inline]]
-    std::optional<ParsedMessage> parse_execute_with_price(const uint8_t* data, ParsedMessage& msg) noexcept {
-        const auto* wire_msg = reinterpret_cast<const ExecuteOrderWithPriceMessage*>(data);
-        
-        msg.execute_with_price.header.message_type = wire_msg->header.message_type;
-        msg.execute_with_price.header.stock_locate = ntoh16(wire_msg->header.stock_locate);
-        msg.execute_with_price.header.tracking_number = ntoh16(wire_msg->header.tracking_number);
-        msg.execute_with_price.header.timestamp = ntoh64(wire_msg->header.timestamp);
-        
-        msg.execute_with_price.order_reference_number = ntoh64(wire_msg->order_reference_number);
-        msg.execute_with_price.executed_shares = ntoh32(wire_msg->executed_shares);
-        msg.execute_with_price.match_number = ntoh64(wire_msg->match_number);
-        msg.execute_with_price.printable = wire_msg->printable;
-        msg.execute_with_price.execution_price = ntoh32(wire_msg->execution_price);
-        
-        msg.parse_timestamp_ns = get_timestamp_ns();
-        return msg;
+    SymbolFilter* filter_ = nullptr;
+    
+    // Receive time shared by the messages of the current batch (PER_BATCH)
+    uint64_t batch_timestamp_ = 0;
+    
+    [[gnu::always_inline]] void stamp_batch() noexcept {
+        if constexpr (Timestamps == TimestampMode::PER_BATCH) {
+            batch_timestamp_ = get_timestamp_ns();
+        }
     }
     
-    [[gnu::always_inline]]
-    std::optional<ParsedMessage> parse_order_cancel(const uint8_t* data, ParsedMessage& msg) noexcept {
-        const auto* wire_msg = reinterpret_cast<const OrderCancelMessage*>(data);
-        
-        msg.order_cancel.header.message_type = wire_msg->header.message_type;
-        msg.order_cancel.header.stock_locate = ntoh16(wire_msg->header.stock_locate);
-        msg.order_cancel.header.tracking_number = ntoh16(wire_msg->header.tracking_number);
-        msg.order_cancel.header.timestamp = ntoh64(wire_msg->header.timestamp);
-        
-        msg.order_cancel.order_reference_number = ntoh64(wire_msg->order_reference_number);
-        msg.order_cancel.cancelled_shares = ntoh32(wire_msg->cancelled_shares);
-        
-        msg.parse_timestamp_ns = get_timestamp_ns();
-        return msg;
+    enum class FrameStatus : uint8_t {
+        DELIVERED,
+        FILTERED,
+        INVALID
+    };
+    
+    static void count_frame(BatchResult& result, FrameStatus status) noexcept {
+        switch (status) {
+            case FrameStatus::DELIVERED: ++result.messages_parsed; break;
+            case FrameStatus::FILTERED:  ++result.messages_filtered; break;
+            case FrameStatus::INVALID:   ++result.messages_skipped; break;
+        }
     }
     
-    [[gnu::always_inline]]
-    std::optional<ParsedMessage> parse_order_delete(const uint8_t* data, ParsedMessage& msg) noexcept {
-        const auto* wire_msg = reinterpret_cast<const OrderDeleteMessage*>(data);
-        
-        msg.order_delete.header.message_type = wire_msg->header.message_type;
-        msg.order_delete.header.stock_locate = ntoh16(wire_msg->header.stock_locate);
-        msg.order_delete.header.tracking_number = ntoh16(wire_msg->header.tracking_number);
-        msg.order_delete.header.timestamp = ntoh64(wire_msg->header.timestamp);
-        
-        msg.order_delete.order_reference_number = ntoh64(wire_msg->order_reference_number);
+    // Frame loop shared by parse_batch and parse_stream (no stamping)
+    template<typename Handler>
+    BatchResult walk_frames(const uint8_t* data, size_t length, Handler& handler) noexcept {
+        BatchResult result;
+        size_t offset = 0;
+        
+        while (offset + FRAME_PREFIX_SIZE <= length) {
+            const size_t msg_len = read_frame_length(data + offset);
+            const size_t frame_len = FRAME_PREFIX_SIZE + msg_len;
+            
+            if (offset + frame_len > length) [[unlikely]] {
+                break;
+            }
+            
+            // Frames are contiguous, so pulling in the bytes a few messages
+            // ahead hides the miss by the time we get there
+            __builtin_prefetch(data + offset + frame_len + PREFETCH_DISTANCE, 0, 3);
+            
+            count_frame(result, dispatch_frame(data + offset + FRAME_PREFIX_SIZE, msg_len, handler));
+            
+            offset += frame_len;
+        }
         
-        msg.parse_timestamp_ns = get_timestamp_ns();
-        return msg;
+        result.bytes_consumed = offset;
+        return result;
     }
     
-    [[gnu::always_inline]]
-    std::optional<ParsedMessage> parse_order_replace(const uint8_t* data, ParsedMessage& msg) noexcept {
-        const auto* wire_msg = reinterpret_cast<const OrderReplaceMessage*>(data);
-        
-        msg.order_replace.header.message_type = wire_msg->header.message_type;
-        msg.order_replace.header.stock_locate = ntoh16(wire_msg->header.stock_locate);
-        msg.order_replace.header.tracking_number = ntoh16(wire_msg->header.tracking_number);
-        msg.order_replace.header.timestamp = ntoh64(wire_msg->header.timestamp);
-        
-        msg.order_replace.original_order_reference_number = ntoh64(wire_msg->original_order_reference_number);
-        msg.order_replace.new_order_reference_number = ntoh64(wire_msg->new_order_reference_number);
-        msg.order_replace.shares = ntoh32(wire_msg->shares);
-        msg.order_replace.price = ntoh32(wire_msg->price);
-        
-        msg.parse_timestamp_ns = get_timestamp_ns();
-        return msg;
+    // Symbol stage, run after length validation and before any decode;
+    // it must see every stock directory message, subscribed or not
+    [[gnu::always_inline]] bool passes_filter(const uint8_t* data) noexcept {
+        return filter_ == nullptr || filter_->admit(data);
     }
     
     [[gnu::always_inline]]
-    std::optional<ParsedMessage> parse_trade(const uint8_t* data, ParsedMessage& msg) noexcept {
-        const auto* wire_msg = reinterpret_cast<const TradeMessage*>(data);
-        
-        msg.trade.header.message_type = wire_msg->header.message_type;
-        msg.trade.header.stock_locate = ntoh16(wire_msg->header.stock_locate);
-        msg.trade.header.tracking_number = ntoh16(wire_msg->header.tracking_number);
-        msg.trade.header.timestamp = ntoh64(wire_msg->header.timestamp);
-        
-        msg.trade.order_reference_number = ntoh64(wire_msg->order_reference_number);
-        msg.trade.buy_sell_indicator = wire_msg->buy_sell_indicator;
-        msg.trade.shares = ntoh32(wire_msg->shares);
-        msg.trade.stock = wire_msg->stock;
-        msg.trade.price = ntoh32(wire_msg->price);
-        msg.trade.match_number = ntoh64(wire_msg->match_number);
-        
-        msg.parse_timestamp_ns = get_timestamp_ns();
+    ParsedMessage build_message(const DispatchEntry& entry, const uint8_t* data) noexcept {
+        ParsedMessage msg;
+        msg.type = static_cast<MessageType>(data[0]);
+        entry.decode(data, msg);
+        if constexpr (Timestamps == TimestampMode::PER_MESSAGE) {
+            msg.parse_timestamp_ns = get_timestamp_ns();
+        } else if constexpr (Timestamps == TimestampMode::PER_BATCH) {
+            msg.parse_timestamp_ns = batch_timestamp_;
+        } else {
+            msg.parse_timestamp_ns = 0;
+        }
         return msg;
     }
     
+    // One table load covers validation, subscription and dispatch;
+    // unknown type bytes have length 0 and never match
+    template<typename Handler>
     [[gnu::always_inline]]
-    std::optional<ParsedMessage> parse_system_event(const uint8_t* data, ParsedMessage& msg) noexcept {
-        const auto* wire_msg = reinterpret_cast<const SystemEventMessage*>(data);
-        
-        msg.system_event.header.message_type = wire_msg->header.message_type;
-        msg.system_event.header.stock_locate = ntoh16(wire_msg->header.stock_locate);
-        msg.system_event.header.tracking_number = ntoh16(wire_msg->header.tracking_number);
-        msg.system_event.header.timestamp = ntoh64(wire_msg->header.timestamp);
-        
-        msg.system_event.event_code = wire_msg->event_code;
+    FrameStatus deliver_frame(const uint8_t* data, size_t length, Handler& handler) noexcept {
+        if (length < sizeof(ITCHMessageHeader)) [[unlikely]] {
+            return FrameStatus::INVALID;
+        }
         
-        msg.parse_timestamp_ns = get_timestamp_ns();
-        return msg;
+        const HandlerEntry<Handler>& entry = HANDLER_TABLE<Handler, Subscription>[data[0]];
+        if (length != entry.length) [[unlikely]] {
+            return FrameStatus::INVALID;
+        }
+        if (!passes_filter(data) || entry.deliver == nullptr) {
+            return FrameStatus::FILTERED;
+        }
+        entry.deliver(data, handler);
+        return FrameStatus::DELIVERED;
     }
     
+    // Frame-level dispatch used by parse_batch/parse_stream, accepting either
+    // a ParsedMessage callable or an on_* handler
+    template<typename Handler>
     [[gnu::always_inline]]
-    std::optional<ParsedMessage> parse_stock_directory(const uint8_t* data, ParsedMessage& msg) noexcept {
-        const auto* wire_msg = reinterpret_cast<const StockDirectoryMessage*>(data);
-        
-        msg.stock_directory.header.message_type = wire_msg->header.message_type;
-        msg.stock_directory.header.stock_locate = ntoh16(wire_msg->header.stock_locate);
-        msg.stock_directory.header.tracking_number = ntoh16(wire_msg->header.tracking_number);
-        msg.stock_directory.header.timestamp = ntoh64(wire_msg->header.timestamp);
-        
-        msg.stock_directory.stock = wire_msg->stock;
-        msg.stock_directory.market_category = wire_msg->market_category;
-        msg.stock_directory.financial_status_indicator = wire_msg->financial_status_indicator;
-        msg.stock_directory.round_lot_size = ntoh32(wire_msg->round_lot_size);
-        msg.stock_directory.round_lots_only = wire_msg->round_lots_only;
-        msg.stock_directory.issue_classification = wire_msg->issue_classification;
-        msg.stock_directory.issue_sub_type = wire_msg->issue_sub_type;
-        msg.stock_directory.authenticity = wire_msg->authenticity;
-        msg.stock_directory.short_sale_threshold_indicator = wire_msg->short_sale_threshold_indicator;
-        msg.stock_directory.ipo_flag = wire_msg->ipo_flag;
-        msg.stock_directory.luld_reference_price_tier = wire_msg->luld_reference_price_tier;
-        msg.stock_directory.etp_flag = wire_msg->etp_flag;
-        msg.stock_directory.etp_leverage_factor = ntoh32(wire_msg->etp_leverage_factor);
-        msg.stock_directory.inverse_indicator = wire_msg->inverse_indicator;
-        
-        msg.parse_timestamp_ns = get_timestamp_ns();
-        return msg;
+    FrameStatus dispatch_frame(const uint8_t* data, size_t length, Handler& handler) noexcept {
+        if constexpr (std::is_invocable_v<Handler&, const ParsedMessage&>) {
+            if (length < sizeof(ITCHMessageHeader)) [[unlikely]] {
+                return FrameStatus::INVALID;
+            }
+            
+            const DispatchEntry& entry = DISPATCH_TABLE<Subscription>[data[0]];
+            if (length != entry.length) [[unlikely]] {
+                return FrameStatus::INVALID;
+            }
+            if (!passes_filter(data) || entry.decode == nullptr) {
+                return FrameStatus::FILTERED;
+            }
+            handler(build_message(entry, data));
+            return FrameStatus::DELIVERED;
+        } else {
+            return deliver_frame(data, length, handler);
+        }
     }
 };
 
+/**
+ * Parser decoding every ITCH 5.0 message type
+ */
+using ITCHParser = BasicITCHParser<>;
+
 } // namespace fast_market
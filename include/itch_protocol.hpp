@@ -35,9 +35,23 @@ enum class MessageType : uint8_t {
     CROSS_TRADE = 'Q',
     BROKEN_TRADE = 'B',
     NOII = 'I',
-    RPII = 'N'
+    RPII = 'N',
+    DLCR_PRICE_DISCOVERY = 'O'
 };
 
+/**
+ * 48-bit ITCH timestamp (nanoseconds since midnight)
+ * Split into high 16 / low 32 bits so each half maps onto a native byte swap
+ */
+struct Timestamp48 {
+    uint16_t high;
+    uint32_t low;
+    
+    [[nodiscard]] constexpr uint64_t value() const noexcept {
+        return (static_cast<uint64_t>(high) << 32) | low;
+    }
+} __attribute__((packed));
+
 /**
  * Common header for all ITCH messages
  * Wire format is big-endian, we handle conversion during parsing
@@ -46,7 +60,7 @@ struct ITCHMessageHeader {
     uint8_t message_type;
     uint16_t stock_locate;
     uint16_t tracking_number;
-    uint64_t timestamp;  // Nanoseconds since midnight
+    Timestamp48 timestamp;  // Nanoseconds since midnight
 } __attribute__((packed));
 
 /**
@@ -156,8 +170,209 @@ struct StockDirectoryMessage {
     uint8_t inverse_indicator;
 } __attribute__((packed));
 
+/**
+ * Stock Trading Action Message (Type H)
+ */
+struct StockTradingActionMessage {
+    ITCHMessageHeader header;
+    std::array<char, 8> stock;
+    uint8_t trading_state;  // 'H', 'P', 'Q', 'T'
+    uint8_t reserved;
+    std::array<char, 4> reason;
+} __attribute__((packed));
+
+/**
+ * Reg SHO Short Sale Price Test Restricted Indicator (Type Y)
+ */
+struct RegSHORestrictionMessage {
+    ITCHMessageHeader header;
+    std::array<char, 8> stock;
+    uint8_t reg_sho_action;  // '0', '1', '2'
+} __attribute__((packed));
+
+/**
+ * Market Participant Position Message (Type L)
+ */
+struct MarketParticipantPositionMessage {
+    ITCHMessageHeader header;
+    std::array<char, 4> mpid;
+    std::array<char, 8> stock;
+    uint8_t primary_market_maker;  // 'Y' or 'N'
+    uint8_t market_maker_mode;
+    uint8_t market_participant_state;
+} __attribute__((packed));
+
+/**
+ * MWCB Decline Level Message (Type V)
+ * Prices are fixed point with 8 decimal places
+ */
+struct MWCBDeclineLevelMessage {
+    ITCHMessageHeader header;
+    uint64_t level1;
+    uint64_t level2;
+    uint64_t level3;
+} __attribute__((packed));
+
+/**
+ * MWCB Status Message (Type W)
+ */
+struct MWCBStatusMessage {
+    ITCHMessageHeader header;
+    uint8_t breached_level;  // '1', '2', '3'
+} __attribute__((packed));
+
+/**
+ * IPO Quoting Period Update Message (Type K)
+ */
+struct IPOQuotingPeriodMessage {
+    ITCHMessageHeader header;
+    std::array<char, 8> stock;
+    uint32_t ipo_quotation_release_time;  // Seconds since midnight
+    uint8_t ipo_quotation_release_qualifier;
+    uint32_t ipo_price;
+} __attribute__((packed));
+
+/**
+ * LULD Auction Collar Message (Type J)
+ */
+struct LULDAuctionCollarMessage {
+    ITCHMessageHeader header;
+    std::array<char, 8> stock;
+    uint32_t auction_collar_reference_price;
+    uint32_t upper_auction_collar_price;
+    uint32_t lower_auction_collar_price;
+    uint32_t auction_collar_extension;
+} __attribute__((packed));
+
+/**
+ * Operational Halt Message (Type h)
+ */
+struct OperationalHaltMessage {
+    ITCHMessageHeader header;
+    std::array<char, 8> stock;
+    uint8_t market_code;  // 'Q', 'B', 'X'
+    uint8_t operational_halt_action;  // 'H' or 'T'
+} __attribute__((packed));
+
+/**
+ * Add Order with MPID Attribution Message (Type F)
+ */
+struct AddOrderMPIDMessage {
+    ITCHMessageHeader header;
+    uint64_t order_reference_number;
+    uint8_t buy_sell_indicator;
+    uint32_t shares;
+    std::array<char, 8> stock;
+    uint32_t price;
+    std::array<char, 4> attribution;
+} __attribute__((packed));
+
+/**
+ * Cross Trade Message (Type Q)
+ */
+struct CrossTradeMessage {
+    ITCHMessageHeader header;
+    uint64_t shares;
+    std::array<char, 8> stock;
+    uint32_t cross_price;
+    uint64_t match_number;
+    uint8_t cross_type;  // 'O', 'C', 'H'
+} __attribute__((packed));
+
+/**
+ * Broken Trade Message (Type B)
+ */
+struct BrokenTradeMessage {
+    ITCHMessageHeader header;
+    uint64_t match_number;
+} __attribute__((packed));
+
+/**
+ * Net Order Imbalance Indicator Message (Type I)
+ */
+struct NOIIMessage {
+    ITCHMessageHeader header;
+    uint64_t paired_shares;
+    uint64_t imbalance_shares;
+    uint8_t imbalance_direction;  // 'B', 'S', 'N', 'O', 'P'
+    std::array<char, 8> stock;
+    uint32_t far_price;
+    uint32_t near_price;
+    uint32_t current_reference_price;
+    uint8_t cross_type;
+    uint8_t price_variation_indicator;
+} __attribute__((packed));
+
+/**
+ * Retail Price Improvement Indicator Message (Type N)
+ */
+struct RPIIMessage {
+    ITCHMessageHeader header;
+    std::array<char, 8> stock;
+    uint8_t interest_flag;  // 'B', 'S', 'A', 'N'
+} __attribute__((packed));
+
+/**
+ * Direct Listing with Capital Raise Price Discovery Message (Type O)
+ */
+struct DLCRPriceDiscoveryMessage {
+    ITCHMessageHeader header;
+    std::array<char, 8> stock;
+    uint8_t open_eligibility_status;  // 'N' or 'Y'
+    uint32_t minimum_allowable_price;
+    uint32_t maximum_allowable_price;
+    uint32_t near_execution_price;
+    uint64_t near_execution_time;
+    uint32_t lower_price_range_collar;
+    uint32_t upper_price_range_collar;
+} __attribute__((packed));
+
 #pragma pack(pop)
 
+/**
+ * Wire length of each message type (excluding any framing)
+ * Returns 0 for type bytes that are not part of ITCH 5.0
+ */
+constexpr uint8_t message_length(MessageType type) noexcept {
+    switch (type) {
+        case MessageType::SYSTEM_EVENT:                return sizeof(SystemEventMessage);
+        case MessageType::STOCK_DIRECTORY:             return sizeof(StockDirectoryMessage);
+        case MessageType::STOCK_TRADING_ACTION:        return sizeof(StockTradingActionMessage);
+        case MessageType::REG_SHO_RESTRICTION:         return sizeof(RegSHORestrictionMessage);
+        case MessageType::MARKET_PARTICIPANT_POSITION: return sizeof(MarketParticipantPositionMessage);
+        case MessageType::MWCB_DECLINE_LEVEL:          return sizeof(MWCBDeclineLevelMessage);
+        case MessageType::MWCB_STATUS:                 return sizeof(MWCBStatusMessage);
+        case MessageType::IPO_QUOTING_PERIOD:          return sizeof(IPOQuotingPeriodMessage);
+        case MessageType::LULD_AUCTION_COLLAR:         return sizeof(LULDAuctionCollarMessage);
+        case MessageType::OPERATIONAL_HALT:            return sizeof(OperationalHaltMessage);
+        case MessageType::ADD_ORDER:                   return sizeof(AddOrderMessage);
+        case MessageType::ADD_ORDER_MPID:              return sizeof(AddOrderMPIDMessage);
+        case MessageType::EXECUTE_ORDER:               return sizeof(ExecuteOrderMessage);
+        case MessageType::EXECUTE_ORDER_WITH_PRICE:    return sizeof(ExecuteOrderWithPriceMessage);
+        case MessageType::ORDER_CANCEL:                return sizeof(OrderCancelMessage);
+        case MessageType::ORDER_DELETE:                return sizeof(OrderDeleteMessage);
+        case MessageType::ORDER_REPLACE:               return sizeof(OrderReplaceMessage);
+        case MessageType::TRADE:                       return sizeof(TradeMessage);
+        case MessageType::CROSS_TRADE:                 return sizeof(CrossTradeMessage);
+        case MessageType::BROKEN_TRADE:                return sizeof(BrokenTradeMessage);
+        case MessageType::NOII:                        return sizeof(NOIIMessage);
+        case MessageType::RPII:                        return sizeof(RPIIMessage);
+        case MessageType::DLCR_PRICE_DISCOVERY:        return sizeof(DLCRPriceDiscoveryMessage);
+    }
+    return 0;
+}
+
+/**
+ * Type byte -> wire length lookup, one load instead of a switch
+ */
+inline constexpr std::array<uint8_t, 256> MESSAGE_LENGTHS = [] {
+    std::array<uint8_t, 256> lengths{};
+    for (size_t i = 0; i < lengths.size(); ++i) {
+        lengths[i] = message_length(static_cast<MessageType>(i));
+    }
+    return lengths;
+}();
+
 /**
  * Parsed message union for efficient storage
  * Uses a union to avoid heap allocations
@@ -175,9 +390,24 @@ struct ParsedMessage {
         TradeMessage trade;
         SystemEventMessage system_event;
         StockDirectoryMessage stock_directory;
+        StockTradingActionMessage stock_trading_action;
+        RegSHORestrictionMessage reg_sho_restriction;
+        MarketParticipantPositionMessage market_participant_position;
+        MWCBDeclineLevelMessage mwcb_decline_level;
+        MWCBStatusMessage mwcb_status;
+        IPOQuotingPeriodMessage ipo_quoting_period;
+        LULDAuctionCollarMessage luld_auction_collar;
+        OperationalHaltMessage operational_halt;
+        AddOrderMPIDMessage add_order_mpid;
+        CrossTradeMessage cross_trade;
+        BrokenTradeMessage broken_trade;
+        NOIIMessage noii;
+        RPIIMessage rpii;
+        DLCRPriceDiscoveryMessage dlcr_price_discovery;
     };
     
-    // Timestamp when parsed (for latency measurement)
+    // Timestamp when parsed (for latency measurement); how often it is
+    // taken, if at all, is set by the parser's TimestampMode
     uint64_t parse_timestamp_ns;
 };
 
@@ -197,6 +427,18 @@ struct ParsedMessage {
     return __builtin_bswap64(x);
 }
 
+[[gnu::always_inline]] inline Timestamp48 ntoh48(Timestamp48 x) {
+    return Timestamp48{ntoh16(x.high), ntoh32(x.low)};
+}
+
+/**
+ * Encode a host nanosecond timestamp into wire (big-endian) order
+ */
+[[gnu::always_inline]] inline Timestamp48 hton48(uint64_t ns) {
+    return Timestamp48{__builtin_bswap16(static_cast<uint16_t>(ns >> 32)),
+                       __builtin_bswap32(static_cast<uint32_t>(ns))};
+}
+
 /**
  * Fixed-point price to double conversion
  * Price is stored as integer with 4 decimal places
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "itch_protocol.hpp"
+#include <string_view>
+
+namespace fast_market {
+
+/**
+ * Read-only view over the common header of a message in wire format
+ * Nothing is decoded up front: each accessor byte-swaps its own field,
+ * so filtering on type and stock_locate touches only 3 bytes
+ */
+class HeaderView {
+public:
+    explicit HeaderView(const uint8_t* data) noexcept : data_(data) {}
+    
+    [[nodiscard]] MessageType type() const noexcept {
+        return static_cast<MessageType>(data_[0]);
+    }
+    
+    [[nodiscard]] uint16_t stock_locate() const noexcept {
+        return ntoh16(header()->stock_locate);
+    }
+    
+    [[nodiscard]] uint16_t tracking_number() const noexcept {
+        return ntoh16(header()->tracking_number);
+    }
+    
+    // Nanoseconds since midnight
+    [[nodiscard]] uint64_t timestamp() const noexcept {
+        return ntoh48(header()->timestamp).value();
+    }
+    
+    // Raw wire bytes, starting at the type byte
+    [[nodiscard]] const uint8_t* data() const noexcept {
+        return data_;
+    }
+    
+protected:
+    [[nodiscard]] const ITCHMessageHeader* header() const noexcept {
+        return reinterpret_cast<const ITCHMessageHeader*>(data_);
+    }
+    
+    const uint8_t* data_;
+};
+
+/**
+ * View over a complete message of type Msg
+ * Use decode_message(view) (itch_dispatch.hpp) to materialize the whole
+ * host-order struct when every field is needed
+ */
+template<typename Msg>
+class MessageView : public HeaderView {
+public:
+    using Message = Msg;
+    
+    using HeaderView::HeaderView;
+    
+    static constexpr size_t size() noexcept {
+        return sizeof(Msg);
+    }
+    
+    // Packed wire struct (still big-endian)
+    [[nodiscard]] const Msg* wire() const noexcept {
+        return reinterpret_cast<const Msg*>(data_);
+    }
+};
+
+class SystemEventView : public MessageView<SystemEventMessage> {
+public:
+    using MessageView::MessageView;
+    
+    [[nodiscard]] uint8_t event_code() const noexcept { return wire()->event_code; }
+};
+
+class StockDirectoryView : public MessageView<StockDirectoryMessage> {
+public:
+    using MessageView::MessageView;
+    
+    [[nodiscard]] const std::array<char, 8>& stock() const noexcept { return wire()->stock; }
+    [[nodiscard]] std::string_view symbol() const noexcept { return get_stock_symbol(wire()->stock); }
+    [[nodiscard]] uint8_t market_category() const noexcept { return wire()->market_category; }
+    [[nodiscard]] uint8_t financial_status_indicator() const noexcept { return wire()->financial_status_indicator; }
+    [[nodiscard]] uint32_t round_lot_size() const noexcept { return ntoh32(wire()->round_lot_size); }
+    [[nodiscard]] uint8_t round_lots_only() const noexcept { return wire()->round_lots_only; }
+    [[nodiscard]] uint8_t issue_classification() const noexcept { return wire()->issue_classification; }
+    [[nodiscard]] const std::array<char, 2>& issue_sub_type() const noexcept { return wire()->issue_sub_type; }
+    [[nodiscard]] uint8_t authenticity() const noexcept { return wire()->authenticity; }
+    [[nodiscard]] uint8_t short_sale_threshold_indicator() const noexcept { return wire()->short_sale_threshold_indicator; }
+    [[nodiscard]] uint8_t ipo_flag() const noexcept { return wire()->ipo_flag; }
+    [[nodiscard]] uint8_t luld_reference_price_tier() const noexcept { return wire()->luld_reference_price_tier; }
+    [[nodiscard]] uint8_t etp_flag() const noexcept { return wire()->etp_flag; }
+    [[nodiscard]] uint32_t etp_leverage_factor() const noexcept { return ntoh32(wire()->etp_leverage_factor); }
+    [[nodiscard]] uint8_t inverse_indicator() const noexcept { return wire()->inverse_indicator; }
+};
+
+class AddOrderView : public MessageView<AddOrderMessage> {
+public:
+    using MessageView::MessageView;
+    
+    [[nodiscard]] uint64_t order_reference_number() const noexcept { return ntoh64(wire()->order_reference_number); }
+    [[nodiscard]] uint8_t buy_sell_indicator() const noexcept { return wire()->buy_sell_indicator; }
+    [[nodiscard]] uint32_t shares() const noexcept { return ntoh32(wire()->shares); }
+    [[nodiscard]] const std::array<char, 8>& stock() const noexcept { return wire()->stock; }
+    [[nodiscard]] std::string_view symbol() const noexcept { return get_stock_symbol(wire()->stock); }
+    [[nodiscard]] uint32_t price() const noexcept { return ntoh32(wire()->price); }
+};
+
+class AddOrderMPIDView : public MessageView<AddOrderMPIDMessage> {
+public:
+    using MessageView::MessageView;
+    
+    [[nodiscard]] uint64_t order_reference_number() const noexcept { return ntoh64(wire()->order_reference_number); }
+    [[nodiscard]] uint8_t buy_sell_indicator() const noexcept { return wire()->buy_sell_indicator; }
+    [[nodiscard]] uint32_t shares() const noexcept { return ntoh32(wire()->shares); }
+    [[nodiscard]] const std::array<char, 8>& stock() const noexcept { return wire()->stock; }
+    [[nodiscard]] std::string_view symbol() const noexcept { return get_stock_symbol(wire()->stock); }
+    [[nodiscard]] uint32_t price() const noexcept { return ntoh32(wire()->price); }
+    [[nodiscard]] const std::array<char, 4>& attribution() const noexcept { return wire()->attribution; }
+};
+
+class ExecuteOrderView : public MessageView<ExecuteOrderMessage> {
+public:
+    using MessageView::MessageView;
+    
+    [[nodiscard]] uint64_t order_reference_number() const noexcept { return ntoh64(wire()->order_reference_number); }
+    [[nodiscard]] uint32_t executed_shares() const noexcept { return ntoh32(wire()->executed_shares); }
+    [[nodiscard]] uint64_t match_number() const noexcept { return ntoh64(wire()->match_number); }
+};
+
+class ExecuteOrderWithPriceView : public MessageView<ExecuteOrderWithPriceMessage> {
+public:
+    using MessageView::MessageView;
+    
+    [[nodiscard]] uint64_t order_reference_number() const noexcept { return ntoh64(wire()->order_reference_number); }
+    [[nodiscard]] uint32_t executed_shares() const noexcept { return ntoh32(wire()->executed_shares); }
+    [[nodiscard]] uint64_t match_number() const noexcept { return ntoh64(wire()->match_number); }
+    [[nodiscard]] uint8_t printable() const noexcept { return wire()->printable; }
+    [[nodiscard]] uint32_t execution_price() const noexcept { return ntoh32(wire()->execution_price); }
+};
+
+class OrderCancelView : public MessageView<OrderCancelMessage> {
+public:
+    using MessageView::MessageView;
+    
+    [[nodiscard]] uint64_t order_reference_number() const noexcept { return ntoh64(wire()->order_reference_number); }
+    [[nodiscard]] uint32_t cancelled_shares() const noexcept { return ntoh32(wire()->cancelled_shares); }
+};
+
+class OrderDeleteView : public MessageView<OrderDeleteMessage> {
+public:
+    using MessageView::MessageView;
+    
+    [[nodiscard]] uint64_t order_reference_number() const noexcept { return ntoh64(wire()->order_reference_number); }
+};
+
+class OrderReplaceView : public MessageView<OrderReplaceMessage> {
+public:
+    using MessageView::MessageView;
+    
+    [[nodiscard]] uint64_t original_order_reference_number() const noexcept { return ntoh64(wire()->original_order_reference_number); }
+    [[nodiscard]] uint64_t new_order_reference_number() const noexcept { return ntoh64(wire()->new_order_reference_number); }
+    [[nodiscard]] uint32_t shares() const noexcept { return ntoh32(wire()->shares); }
+    [[nodiscard]] uint32_t price() const noexcept { return ntoh32(wire()->price); }
+};
+
+class TradeView : public MessageView<TradeMessage> {
+public:
+    using MessageView::MessageView;
+    
+    [[nodiscard]] uint64_t order_reference_number() const noexcept { return ntoh64(wire()->order_reference_number); }
+    [[nodiscard]] uint8_t buy_sell_indicator() const noexcept { return wire()->buy_sell_indicator; }
+    [[nodiscard]] uint32_t shares() const noexcept { return ntoh32(wire()->shares); }
+    [[nodiscard]] const std::array<char, 8>& stock() const noexcept { return wire()->stock; }
+    [[nodiscard]] std::string_view symbol() const noexcept { return get_stock_symbol(wire()->stock); }
+    [[nodiscard]] uint32_t price() const noexcept { return ntoh32(wire()->price); }
+    [[nodiscard]] uint64_t match_number() const noexcept { return ntoh64(wire()->match_number); }
+};
+
+class CrossTradeView : public MessageView<CrossTradeMessage> {
+public:
+    using MessageView::MessageView;
+    
+    [[nodiscard]] uint64_t shares() const noexcept { return ntoh64(wire()->shares); }
+    [[nodiscard]] const std::array<char, 8>& stock() const noexcept { return wire()->stock; }
+    [[nodiscard]] std::string_view symbol() const noexcept { return get_stock_symbol(wire()->stock); }
+    [[nodiscard]] uint32_t cross_price() const noexcept { return ntoh32(wire()->cross_price); }
+    [[nodiscard]] uint64_t match_number() const noexcept { return ntoh64(wire()->match_number); }
+    [[nodiscard]] uint8_t cross_type() const noexcept { return wire()->cross_type; }
+};
+
+class BrokenTradeView : public MessageView<BrokenTradeMessage> {
+public:
+    using MessageView::MessageView;
+    
+    [[nodiscard]] uint64_t match_number() const noexcept { return ntoh64(wire()->match_number); }
+};
+
+// Administrative and auction messages are rare enough that consumers
+// usually decode them in full; the generic view gives header access
+using StockTradingActionView = MessageView<StockTradingActionMessage>;
+using RegSHORestrictionView = MessageView<RegSHORestrictionMessage>;
+using MarketParticipantPositionView = MessageView<MarketParticipantPositionMessage>;
+using MWCBDeclineLevelView = MessageView<MWCBDeclineLevelMessage>;
+using MWCBStatusView = MessageView<MWCBStatusMessage>;
+using IPOQuotingPeriodView = MessageView<IPOQuotingPeriodMessage>;
+using LULDAuctionCollarView = MessageView<LULDAuctionCollarMessage>;
+using OperationalHaltView = MessageView<OperationalHaltMessage>;
+using NOIIView = MessageView<NOIIMessage>;
+using RPIIView = MessageView<RPIIMessage>;
+using DLCRPriceDiscoveryView = MessageView<DLCRPriceDiscoveryMessage>;
+
+} // namespace fast_market
@@ -0,0 +1,201 @@
+#pragma once
+
+#include "compact_log.hpp"
+#include "itch_protocol.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fast_market {
+
+/**
+ * Record layout of an indexed log
+ */
+enum class LogFormat : uint32_t {
+    ROW = 0,        // Packed structs back to back (MMAP / BUFFERED)
+    COMPACT = 1     // CompactEncoder records after a CompactLogHeader
+};
+
+/**
+ * Sidecar index file header; entries follow it
+ */
+struct LogIndexHeader {
+    uint64_t magic;
+    uint32_t version;
+    LogFormat format;
+    uint64_t every_records;
+    uint64_t every_ns;
+};
+
+/**
+ * One index point: the record at offset is the ordinal-th record logged
+ * (from 0) and carries this ITCH timestamp
+ */
+struct LogIndexEntry {
+    uint64_t timestamp;
+    uint64_t ordinal;
+    uint64_t offset;
+};
+
+/**
+ * Appends sparse index points to a sidecar file while a log is written
+ * A point is due every every_records records or when the feed clock has
+ * moved every_ns since the last point, whichever comes first (0 disables
+ * either trigger). Entries are buffered and written in blocks.
+ */
+class LogIndexWriter {
+public:
+    static constexpr uint64_t MAGIC = 0x3158444948435449ULL;  // "ITCHIDX1"
+    static constexpr uint32_t VERSION = 1;
+    
+    /**
+     * @throws std::runtime_error if the index file cannot be created
+     */
+    LogIndexWriter(const std::string& path, LogFormat format, uint64_t every_records, uint64_t every_ns);
+    ~LogIndexWriter();
+    
+    LogIndexWriter(const LogIndexWriter&) = delete;
+    LogIndexWriter& operator=(const LogIndexWriter&) = delete;
+    
+    [[nodiscard]] bool due(uint64_t ordinal, uint64_t timestamp) const noexcept {
+        return ordinal == 0 ||
+               (every_records_ != 0 && ordinal - last_ordinal_ >= every_records_) ||
+               (every_ns_ != 0 && timestamp - last_timestamp_ >= every_ns_);
+    }
+    
+    void add(uint64_t ordinal, uint64_t timestamp, uint64_t offset) {
+        entries_.push_back(LogIndexEntry{timestamp, ordinal, offset});
+        last_ordinal_ = ordinal;
+        last_timestamp_ = timestamp;
+        ++total_entries_;
+        if (entries_.size() == BLOCK_ENTRIES) [[unlikely]] {
+            write_entries();
+        }
+    }
+    
+    /**
+     * Write buffered entries and close the file
+     */
+    void close();
+    
+    [[nodiscard]] uint64_t entries() const noexcept {
+        return total_entries_;
+    }
+    
+private:
+    static constexpr size_t BLOCK_ENTRIES = 4096;
+    
+    void write_entries();
+    
+    int fd_ = -1;
+    uint64_t every_records_;
+    uint64_t every_ns_;
+    uint64_t last_ordinal_ = 0;
+    uint64_t last_timestamp_ = 0;
+    uint64_t total_entries_ = 0;
+    std::vector<LogIndexEntry> entries_;
+};
+
+/**
+ * Random access into a log written with an index (AsyncLogger::enable_index)
+ * Loads "<log>.idx", maps the log, and starts each query at the nearest
+ * index point found by binary search, so only the pages from that point
+ * on are touched. In compact logs every index point is the start of a
+ * segment (CompactEncoder::start_segment), so decoding can begin there.
+ */
+class IndexedLogReader {
+public:
+    /**
+     * @throws std::runtime_error if the log or its index is missing or malformed
+     */
+    explicit IndexedLogReader(const std::string& log_path);
+    ~IndexedLogReader();
+    
+    IndexedLogReader(const IndexedLogReader&) = delete;
+    IndexedLogReader& operator=(const IndexedLogReader&) = delete;
+    
+    /**
+     * Last index point strictly before timestamp (the first point if none),
+     * so records sharing the timestamp before the point are not skipped
+     */
+    [[nodiscard]] const LogIndexEntry& seek_time(uint64_t timestamp) const noexcept;
+    
+    /**
+     * Last index point at or before ordinal
+     */
+    [[nodiscard]] const LogIndexEntry& seek_ordinal(uint64_t ordinal) const noexcept;
+    
+    /**
+     * Visit records with timestamp >= timestamp, in log order, as
+     * fn(const ParsedMessage&, uint64_t ordinal) until fn returns false
+     * @return Records decoded, including the ones skipped after the index point
+     * @throws std::runtime_error on a corrupt record
+     */
+    template<typename Fn>
+    uint64_t scan_from_time(uint64_t timestamp, Fn&& fn) {
+        return scan(seek_time(timestamp), [&](const ParsedMessage& msg, uint64_t ordinal) {
+            return msg.system_event.header.timestamp.value() < timestamp || fn(msg, ordinal);
+        });
+    }
+    
+    /**
+     * Visit records from the ordinal-th on, as fn(const ParsedMessage&, uint64_t ordinal)
+     * until fn returns false
+     */
+    template<typename Fn>
+    uint64_t scan_from_ordinal(uint64_t ordinal, Fn&& fn) {
+        return scan(seek_ordinal(ordinal), [&](const ParsedMessage& msg, uint64_t current) {
+            return current < ordinal || fn(msg, current);
+        });
+    }
+    
+    [[nodiscard]] LogFormat format() const noexcept {
+        return format_;
+    }
+    
+    [[nodiscard]] const std::vector<LogIndexEntry>& entries() const noexcept {
+        return entries_;
+    }
+    
+private:
+    template<typename Fn>
+    uint64_t scan(const LogIndexEntry& start, Fn&& fn) {
+        ParsedMessage msg;
+        uint64_t ordinal = start.ordinal;
+        size_t offset = start.offset;
+        while (offset < size_) {
+            size_t used = 0;
+            if (format_ == LogFormat::COMPACT) {
+                used = decoder_.decode(base_ + offset, size_ - offset, msg);
+            } else {
+                used = MESSAGE_LENGTHS[base_[offset]];
+                if (used != 0 && used <= size_ - offset) [[likely]] {
+                    msg.type = static_cast<MessageType>(base_[offset]);
+                    msg.parse_timestamp_ns = 0;
+                    std::memcpy(&msg.system_event, base_ + offset, used);
+                } else {
+                    used = 0;
+                }
+            }
+            if (used == 0) [[unlikely]] {
+                throw std::runtime_error("Corrupt log record at offset " + std::to_string(offset));
+            }
+            offset += used;
+            if (!fn(static_cast<const ParsedMessage&>(msg), ordinal++)) {
+                break;
+            }
+        }
+        return ordinal - start.ordinal;
+    }
+    
+    const uint8_t* base_ = nullptr;
+    size_t size_ = 0;
+    LogFormat format_ = LogFormat::ROW;
+    std::vector<LogIndexEntry> entries_;
+    CompactDecoder decoder_;
+};
+
+} // namespace fast_market
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fast_market {
+
+/**
+ * Byte ring mapped twice back-to-back in virtual memory
+ * The region after the end of the buffer aliases its start, so any
+ * readable or writable span is contiguous even when it wraps: a packet
+ * straddling the end can be parsed in place, with no memmove or copy.
+ * Single producer, single consumer, not thread-safe.
+ */
+class MirroredRingBuffer {
+public:
+    /**
+     * @param min_capacity Rounded up to a power-of-two number of pages
+     * @throws std::runtime_error if the mapping cannot be created
+     */
+    explicit MirroredRingBuffer(size_t min_capacity);
+    ~MirroredRingBuffer();
+    
+    MirroredRingBuffer(const MirroredRingBuffer&) = delete;
+    MirroredRingBuffer& operator=(const MirroredRingBuffer&) = delete;
+    
+    [[nodiscard]] size_t capacity() const noexcept {
+        return capacity_;
+    }
+    
+    // Contiguous span of readable() bytes
+    [[nodiscard]] const uint8_t* read_ptr() const noexcept {
+        return base_ + (head_ & mask_);
+    }
+    
+    [[nodiscard]] size_t readable() const noexcept {
+        return static_cast<size_t>(tail_ - head_);
+    }
+    
+    void consume(size_t bytes) noexcept {
+        head_ += bytes;
+    }
+    
+    // Contiguous span of writable() bytes
+    [[nodiscard]] uint8_t* write_ptr() noexcept {
+        return base_ + (tail_ & mask_);
+    }
+    
+    [[nodiscard]] size_t writable() const noexcept {
+        return capacity_ - readable();
+    }
+    
+    void commit(size_t bytes) noexcept {
+        tail_ += bytes;
+    }
+    
+    void clear() noexcept {
+        head_ = tail_ = 0;
+    }
+    
+private:
+    uint8_t* base_ = nullptr;
+    size_t capacity_ = 0;
+    size_t mask_ = 0;
+    uint64_t head_ = 0;  // Total bytes consumed
+    uint64_t tail_ = 0;  // Total bytes committed
+};
+
+} // namespace fast_market
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "itch_parser.hpp"
+#include <array>
+#include <cstdint>
+
+namespace fast_market {
+
+/**
+ * MoldUDP64 downstream packet header (wire format, big-endian)
+ * Followed by message_count blocks of 2-byte length + message, which is
+ * the same framing parse_batch consumes
+ */
+struct MoldUDP64Header {
+    std::array<char, 10> session;
+    uint64_t sequence_number;  // Sequence number of the first message
+    uint16_t message_count;
+} __attribute__((packed));
+
+static_assert(sizeof(MoldUDP64Header) == 20, "MoldUDP64 header must be 20 bytes");
+
+/**
+ * What a packet contributed to the stream
+ */
+enum class PacketStatus : uint8_t {
+    DELIVERED,         // New messages handed to the parser
+    HEARTBEAT,         // No messages; sequence number is the next expected
+    END_OF_SESSION,    // Session closed by the sender
+    DUPLICATE,         // Every message already seen
+    SESSION_MISMATCH,  // Packet belongs to another session, dropped
+    MALFORMED          // Truncated header or blocks not matching message_count
+};
+
+/**
+ * Outcome of MoldUDP64Decoder::process
+ */
+struct PacketResult {
+    PacketStatus status = PacketStatus::MALFORMED;
+    uint64_t sequence_number = 0;
+    uint64_t gap_start = 0;   // First missing sequence number, if gap_count > 0
+    uint64_t gap_count = 0;   // Messages lost before this packet
+    BatchResult batch;        // Parser stats for the delivered messages
+    
+    [[nodiscard]] bool has_gap() const noexcept {
+        return gap_count > 0;
+    }
+};
+
+/**
+ * Running totals for a session
+ */
+struct MoldUDP64Stats {
+    uint64_t packets = 0;
+    uint64_t messages_received = 0;   // New messages passed to the parser
+    uint64_t messages_duplicate = 0;  // Dropped because already seen
+    uint64_t messages_missed = 0;     // Covered by detected gaps
+    uint64_t gaps = 0;
+};
+
+/**
+ * MoldUDP64 session layer on top of the ITCH parser
+ * Validates each packet header, tracks the next expected sequence number
+ * and passes the message blocks to parser.parse_batch in place. Duplicate
+ * (already delivered) messages are dropped, including the overlapping
+ * prefix of a partially repeated packet; gaps are reported on the packet
+ * that reveals them, which is then delivered. Recovery of the missing
+ * range (re-request server, snapshot) is left to the caller.
+ *
+ * The session name and starting sequence number are latched from the
+ * first packet unless expect() was called.
+ */
+class MoldUDP64Decoder {
+public:
+    static constexpr uint16_t END_OF_SESSION_COUNT = 0xFFFF;
+    
+    MoldUDP64Decoder() = default;
+    
+    /**
+     * Decode one datagram
+     * @param packet Start of the UDP payload
+     * @param length Payload length
+     * @param parser Any BasicITCHParser
+     * @param handler Passed through to parser.parse_batch
+     */
+    template<typename Parser, typename Handler>
+    PacketResult process(const uint8_t* packet, size_t length, Parser& parser, Handler&& handler) noexcept {
+        PacketResult result;
+        if (length < sizeof(MoldUDP64Header)) [[unlikely]] {
+            return result;
+        }
+        
+        const auto* header = reinterpret_cast<const MoldUDP64Header*>(packet);
+        const uint64_t sequence = ntoh64(header->sequence_number);
+        const uint16_t count = ntoh16(header->message_count);
+        result.sequence_number = sequence;
+        
+        if (!session_known_) [[unlikely]] {
+            session_ = header->session;
+            session_known_ = true;
+            if (next_sequence_ == 0) {
+                next_sequence_ = sequence;
+            }
+        } else if (header->session != session_) [[unlikely]] {
+            result.status = PacketStatus::SESSION_MISMATCH;
+            return result;
+        }
+        
+        ++stats_.packets;
+        
+        // Heartbeats and end-of-session packets carry the next sequence
+        // number too, so they reveal gaps the same way
+        if (sequence > next_sequence_) [[unlikely]] {
+            result.gap_start = next_sequence_;
+            result.gap_count = sequence - next_sequence_;
+            ++stats_.gaps;
+            stats_.messages_missed += result.gap_count;
+            next_sequence_ = sequence;
+        }
+        
+        if (count == 0) {
+            result.status = PacketStatus::HEARTBEAT;
+            return result;
+        }
+        if (count == END_OF_SESSION_COUNT) [[unlikely]] {
+            result.status = PacketStatus::END_OF_SESSION;
+            return result;
+        }
+        
+        if (sequence + count <= next_sequence_) [[unlikely]] {
+            stats_.messages_duplicate += count;
+            result.status = PacketStatus::DUPLICATE;
+            return result;
+        }
+        
+        const uint8_t* blocks = packet + sizeof(MoldUDP64Header);
+        const size_t available = length - sizeof(MoldUDP64Header);
+        
+        // Walk the frames message_count declares: the already-delivered
+        // prefix of an overlapping packet is stepped over, and bytes past
+        // the last declared frame are never handed to the parser
+        const uint64_t overlap = next_sequence_ - sequence;
+        size_t prefix_bytes = 0;
+        size_t packet_bytes = 0;
+        uint64_t frames_seen = 0;
+        while (frames_seen < count && packet_bytes + Parser::FRAME_PREFIX_SIZE <= available) {
+            const size_t frame_len = Parser::FRAME_PREFIX_SIZE + Parser::read_frame_length(blocks + packet_bytes);
+            if (frame_len > available - packet_bytes) [[unlikely]] {
+                break;
+            }
+            packet_bytes += frame_len;
+            if (++frames_seen == overlap) {
+                prefix_bytes = packet_bytes;
+            }
+        }
+        if (frames_seen < overlap) [[unlikely]] {
+            return result;
+        }
+        stats_.messages_duplicate += overlap;
+        
+        const size_t new_bytes = packet_bytes - prefix_bytes;
+        result.batch = parser.parse_batch(blocks + prefix_bytes, new_bytes, handler);
+        const uint64_t frames = result.batch.messages_parsed + result.batch.messages_skipped
+                              + result.batch.messages_filtered;
+        next_sequence_ += frames;
+        stats_.messages_received += frames;
+        
+        // A short packet advances only past what it held; the rest shows
+        // up as a gap on the next packet
+        if (frames == count - overlap && result.batch.bytes_consumed == new_bytes &&
+            packet_bytes == available) [[likely]] {
+            result.status = PacketStatus::DELIVERED;
+        }
+        return result;
+    }
+    
+    /**
+     * Start from a known sequence number (e.g. 1 at start of day, or the
+     * first sequence after a snapshot) instead of the first packet seen
+     */
+    void expect(uint64_t sequence_number) noexcept {
+        next_sequence_ = sequence_number;
+    }
+    
+    /**
+     * Forget the session and sequence state, e.g. for a new trading day
+     */
+    void reset() noexcept {
+        session_known_ = false;
+        next_sequence_ = 0;
+        stats_ = MoldUDP64Stats{};
+    }
+    
+    [[nodiscard]] uint64_t next_sequence() const noexcept {
+        return next_sequence_;
+    }
+    
+    [[nodiscard]] const std::array<char, 10>& session() const noexcept {
+        return session_;
+    }
+    
+    [[nodiscard]] const MoldUDP64Stats& stats() const noexcept {
+        return stats_;
+    }
+    
+private:
+    std::array<char, 10> session_{};
+    bool session_known_ = false;
+    uint64_t next_sequence_ = 0;
+    MoldUDP64Stats stats_;
+};
+
+} // namespace fast_market
@@ -122,4 +122,101 @@ private:
     AlignedType<std::atomic<size_t>> sequences_[Capacity];
 };
 
+/**
+ * Lock-free Single Producer Single Consumer ring
+ * Slots are filled and read in place: the producer writes into
+ * producer_slot() and publishes it, the consumer reads front() and pops it.
+ * Each side caches the other's index and only reloads it when the ring
+ * looks full (or empty), so steady-state traffic touches one shared line
+ * per slot.
+ */
+template<typename T, size_t Capacity>
+class SPSCQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of 2");
+    
+public:
+    SPSCQueue() = default;
+    
+    // Non-copyable, non-movable
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+    
+    /**
+     * Next free slot, or nullptr if the ring is full (producer only)
+     */
+    [[nodiscard]] T* producer_slot() noexcept {
+        const size_t head = head_.value.load(std::memory_order_relaxed);
+        if (head - cached_tail_.value == Capacity) [[unlikely]] {
+            cached_tail_.value = tail_.value.load(std::memory_order_acquire);
+            if (head - cached_tail_.value == Capacity) {
+                return nullptr;
+            }
+        }
+        return &buffer_[head & (Capacity - 1)];
+    }
+    
+    /**
+     * Make the slot from producer_slot() visible to the consumer
+     */
+    void publish() noexcept {
+        head_.value.store(head_.value.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    
+    /**
+     * Oldest published slot, or nullptr if the ring is empty (consumer only)
+     */
+    [[nodiscard]] const T* front() noexcept {
+        const size_t tail = tail_.value.load(std::memory_order_relaxed);
+        if (tail == cached_head_.value) {
+            cached_head_.value = head_.value.load(std::memory_order_acquire);
+            if (tail == cached_head_.value) {
+                return nullptr;
+            }
+        }
+        return &buffer_[tail & (Capacity - 1)];
+    }
+    
+    /**
+     * Hand the slot from front() back to the producer
+     */
+    void pop() noexcept {
+        tail_.value.store(tail_.value.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    
+    [[nodiscard]] bool try_enqueue(const T& item) noexcept {
+        T* slot = producer_slot();
+        if (slot == nullptr) {
+            return false;
+        }
+        *slot = item;
+        publish();
+        return true;
+    }
+    
+    [[nodiscard]] bool try_dequeue(T& item) noexcept {
+        const T* slot = front();
+        if (slot == nullptr) {
+            return false;
+        }
+        item = *slot;
+        pop();
+        return true;
+    }
+    
+    [[nodiscard]] bool empty() const noexcept {
+        return head_.value.load(std::memory_order_acquire) == tail_.value.load(std::memory_order_acquire);
+    }
+    
+private:
+    // Producer line: its index and its view of the consumer's
+    AlignedType<std::atomic<size_t>> head_{{0}};
+    AlignedType<size_t> cached_tail_{0};
+    
+    // Consumer line
+    AlignedType<std::atomic<size_t>> tail_{{0}};
+    AlignedType<size_t> cached_head_{0};
+    
+    T buffer_[Capacity];
+};
+
 } // namespace fast_market
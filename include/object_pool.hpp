@@ -0,0 +1,209 @@
+#pragma once
+
+#include "system_utils.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fast_market {
+
+/**
+ * Usage counters for an ObjectPool
+ */
+struct PoolStats {
+    size_t capacity = 0;        // Objects the current slabs can hold
+    size_t in_use = 0;
+    size_t high_water = 0;      // Most objects ever live at once
+    size_t slabs = 0;
+    uint64_t allocations = 0;
+    bool huge_pages = false;    // Every slab is on explicitly reserved huge pages
+};
+
+/**
+ * Fixed-size slab pool for book nodes (orders, price levels)
+ * Objects are carved from large slabs obtained with
+ * SystemUtils::allocate_large, so they sit on huge pages where available
+ * and neighbouring allocations share cache lines and TLB entries. Freed
+ * objects go on an intrusive free list threaded through their own storage
+ * and are reused last-in first-out, while the memory is still warm.
+ *
+ * A pool belongs to one thread (one per BookManager / shard), so there is
+ * no locking at all. Slabs are never returned before the pool dies; a
+ * slab is only mapped when the previous one is used up, off the hot path.
+ */
+template<typename T>
+class ObjectPool {
+    static_assert(std::is_trivially_destructible_v<T>, "Pooled objects are released without running destructors");
+    
+public:
+    static constexpr size_t DEFAULT_SLAB_BYTES = SystemUtils::HUGE_PAGE_SIZE;
+    
+    /**
+     * @param reserve_objects Objects to map up front (0 maps on first use)
+     * @param slab_bytes Size of each slab mapping; 2 MB and up is rounded
+     *                   to whole huge pages
+     */
+    explicit ObjectPool(size_t reserve_objects = 0, size_t slab_bytes = DEFAULT_SLAB_BYTES)
+        : slab_bytes_(slab_map_size(slab_bytes))
+        , objects_per_slab_(slab_bytes_ / SLOT_SIZE)
+    {
+        reserve(reserve_objects);
+    }
+    
+    ~ObjectPool() {
+        for (const Slab& slab : slabs_) {
+            SystemUtils::free_large(slab.memory, slab.bytes);
+        }
+    }
+    
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+    
+    ObjectPool(ObjectPool&& other) noexcept {
+        swap(other);
+    }
+    
+    ObjectPool& operator=(ObjectPool&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+    
+    /**
+     * Construct an object in pooled storage
+     */
+    template<typename... Args>
+    [[nodiscard]] T* create(Args&&... args) {
+        void* storage;
+        if (free_list_ != nullptr) [[likely]] {
+            storage = free_list_;
+            free_list_ = free_list_->next;
+        } else {
+            if (fresh_ == fresh_end_) [[unlikely]] {
+                next_slab();
+            }
+            storage = fresh_;
+            fresh_ += SLOT_SIZE;
+        }
+        
+        ++stats_.allocations;
+        if (++stats_.in_use > stats_.high_water) {
+            stats_.high_water = stats_.in_use;
+        }
+        return ::new (storage) T(std::forward<Args>(args)...);
+    }
+    
+    /**
+     * Return an object to the pool
+     */
+    void destroy(T* object) noexcept {
+        auto* node = reinterpret_cast<FreeNode*>(object);
+        node->next = free_list_;
+        free_list_ = node;
+        --stats_.in_use;
+    }
+    
+    /**
+     * Map slabs until at least `objects` fit
+     */
+    void reserve(size_t objects) {
+        while (stats_.capacity < objects) {
+            map_slab();
+        }
+        if (fresh_ == nullptr && !slabs_.empty()) {
+            use_slab(0);
+        }
+    }
+    
+    /**
+     * Forget every live object at once; slabs are kept for reuse
+     */
+    void clear() noexcept {
+        free_list_ = nullptr;
+        current_slab_ = 0;
+        fresh_ = fresh_end_ = nullptr;
+        if (!slabs_.empty()) {
+            use_slab(0);
+        }
+        stats_.in_use = 0;
+    }
+    
+    [[nodiscard]] const PoolStats& stats() const noexcept {
+        return stats_;
+    }
+    
+private:
+    // Free slots hold the link in their own storage
+    struct FreeNode {
+        FreeNode* next;
+    };
+    
+    struct Slab {
+        void* memory;
+        size_t bytes;
+    };
+    
+    static constexpr size_t SLOT_SIZE = (std::max(sizeof(T), sizeof(FreeNode)) + alignof(T) - 1) / alignof(T) * alignof(T);
+    
+    // Whole huge pages are mapped even when the slots end short of the
+    // last one (43690 48-byte orders fill 2097120 bytes), otherwise
+    // allocate_large would see less than a huge page and use normal pages
+    static constexpr size_t slab_map_size(size_t slab_bytes) noexcept {
+        if (slab_bytes >= SystemUtils::HUGE_PAGE_SIZE) {
+            return SystemUtils::round_to_huge_page(slab_bytes);
+        }
+        return std::max(slab_bytes, SLOT_SIZE);
+    }
+    
+    void map_slab() {
+        bool huge = false;
+        void* memory = SystemUtils::allocate_large(slab_bytes_, &huge);
+        if (memory == nullptr) {
+            throw std::bad_alloc();
+        }
+        slabs_.push_back(Slab{memory, slab_bytes_});
+        stats_.capacity += objects_per_slab_;
+        stats_.slabs = slabs_.size();
+        stats_.huge_pages = huge && (stats_.slabs == 1 || stats_.huge_pages);
+    }
+    
+    void use_slab(size_t index) noexcept {
+        current_slab_ = index;
+        fresh_ = static_cast<uint8_t*>(slabs_[index].memory);
+        fresh_end_ = fresh_ + objects_per_slab_ * SLOT_SIZE;
+    }
+    
+    // Move bump allocation to the next slab, mapping one if needed
+    [[gnu::noinline]] void next_slab() {
+        const size_t index = (fresh_ == nullptr) ? 0 : current_slab_ + 1;
+        if (index == slabs_.size()) {
+            map_slab();
+        }
+        use_slab(index);
+    }
+    
+    void swap(ObjectPool& other) noexcept {
+        std::swap(slabs_, other.slabs_);
+        std::swap(slab_bytes_, other.slab_bytes_);
+        std::swap(objects_per_slab_, other.objects_per_slab_);
+        std::swap(current_slab_, other.current_slab_);
+        std::swap(fresh_, other.fresh_);
+        std::swap(fresh_end_, other.fresh_end_);
+        std::swap(free_list_, other.free_list_);
+        std::swap(stats_, other.stats_);
+    }
+    
+    std::vector<Slab> slabs_;
+    size_t slab_bytes_ = SLOT_SIZE;
+    size_t objects_per_slab_ = 1;
+    size_t current_slab_ = 0;
+    uint8_t* fresh_ = nullptr;       // Next never-used slot in the current slab
+    uint8_t* fresh_end_ = nullptr;
+    FreeNode* free_list_ = nullptr;
+    PoolStats stats_;
+};
+
+} // namespace fast_market
@@ -0,0 +1,439 @@
+#pragma once
+
+#include "itch_views.hpp"
+#include "flat_order_map.hpp"
+#include "object_pool.hpp"
+#include "price_ladder.hpp"
+#include "top_of_book.hpp"
+#include "symbol_directory.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace fast_market {
+
+enum class Side : uint8_t {
+    BUY,
+    SELL
+};
+
+struct PriceLevel;
+
+/**
+ * Resting order, linked into its price level in time priority
+ */
+struct BookOrder {
+    uint64_t reference = 0;
+    uint32_t price = 0;
+    uint32_t shares = 0;        // Remaining (open) shares
+    uint16_t stock_locate = 0;
+    Side side = Side::BUY;
+    BookOrder* prev = nullptr;
+    BookOrder* next = nullptr;
+    PriceLevel* level = nullptr;
+};
+
+/**
+ * Aggregate of the orders resting at one price, as an intrusive FIFO
+ */
+struct PriceLevel {
+    uint32_t price = 0;
+    uint32_t order_count = 0;
+    uint64_t shares = 0;
+    BookOrder* head = nullptr;  // Oldest order, first to fill
+    BookOrder* tail = nullptr;
+};
+
+/**
+ * Best bid and offer of one book; a price of 0 means that side is empty
+ */
+struct BestBidOffer {
+    uint32_t bid_price = 0;
+    uint32_t ask_price = 0;
+    uint64_t bid_shares = 0;
+    uint64_t ask_shares = 0;
+};
+
+/**
+ * Full-depth (L3) book for one symbol
+ * Each side is a PriceLadder that caches its best level, so reading the
+ * BBO is a pointer load and dropping the best level finds the next one
+ * from a bitmap. Orders are owned by the BookManager; the book only links
+ * them into levels, which it takes from the manager's level pool.
+ */
+class OrderBook {
+public:
+    OrderBook(uint16_t stock_locate, ObjectPool<PriceLevel>& level_pool) noexcept
+        : level_pool_(level_pool)
+        , stock_locate_(stock_locate)
+    {
+    }
+    
+    OrderBook(const OrderBook&) = delete;
+    OrderBook& operator=(const OrderBook&) = delete;
+    
+    /**
+     * Append an order at the back of its price level
+     */
+    void insert(BookOrder* order) {
+        PriceLevel& level = order->side == Side::BUY ? find_or_add(bids_, order->price)
+                                                     : find_or_add(asks_, order->price);
+        order->level = &level;
+        order->next = nullptr;
+        order->prev = level.tail;
+        if (level.tail != nullptr) {
+            level.tail->next = order;
+        } else {
+            level.head = order;
+        }
+        level.tail = order;
+        ++level.order_count;
+        level.shares += order->shares;
+    }
+    
+    /**
+     * Take shares off an order (execution or partial cancel), keeping its priority
+     * @return true if the order is now empty; the caller then calls remove()
+     */
+    [[nodiscard]] bool reduce(BookOrder* order, uint32_t shares) noexcept {
+        const uint32_t taken = shares < order->shares ? shares : order->shares;
+        order->shares -= taken;
+        order->level->shares -= taken;
+        return order->shares == 0;
+    }
+    
+    /**
+     * Unlink an order, dropping its level if it was the last one there
+     */
+    void remove(BookOrder* order) noexcept {
+        PriceLevel* level = order->level;
+        if (order->prev != nullptr) {
+            order->prev->next = order->next;
+        } else {
+            level->head = order->next;
+        }
+        if (order->next != nullptr) {
+            order->next->prev = order->prev;
+        } else {
+            level->tail = order->prev;
+        }
+        --level->order_count;
+        level->shares -= order->shares;
+        order->level = nullptr;
+        
+        if (level->order_count == 0) {
+            if (order->side == Side::BUY) {
+                bids_.erase(level);
+            } else {
+                asks_.erase(level);
+            }
+            level_pool_.destroy(level);
+        }
+    }
+    
+    // Best level of each side, nullptr when that side is empty
+    [[nodiscard]] const PriceLevel* best_bid() const noexcept {
+        return bids_.best();
+    }
+    
+    [[nodiscard]] const PriceLevel* best_ask() const noexcept {
+        return asks_.best();
+    }
+    
+    [[nodiscard]] BestBidOffer bbo() const noexcept {
+        BestBidOffer top;
+        if (const PriceLevel* bid = bids_.best()) {
+            top.bid_price = bid->price;
+            top.bid_shares = bid->shares;
+        }
+        if (const PriceLevel* ask = asks_.best()) {
+            top.ask_price = ask->price;
+            top.ask_shares = ask->shares;
+        }
+        return top;
+    }
+    
+    /**
+     * Level at an exact price, or nullptr
+     */
+    [[nodiscard]] const PriceLevel* level(Side side, uint32_t price) const noexcept {
+        return side == Side::BUY ? bids_.find(price) : asks_.find(price);
+    }
+    
+    [[nodiscard]] size_t depth(Side side) const noexcept {
+        return side == Side::BUY ? bids_.size() : asks_.size();
+    }
+    
+    /**
+     * Visit levels from the best price outwards until fn returns false
+     */
+    template<typename Fn>
+    void for_each_level(Side side, Fn&& fn) const {
+        if (side == Side::BUY) {
+            bids_.for_each(fn);
+        } else {
+            asks_.for_each(fn);
+        }
+    }
+    
+    [[nodiscard]] uint16_t stock_locate() const noexcept {
+        return stock_locate_;
+    }
+    
+    // ITCH timestamp of the last change applied to this book
+    [[nodiscard]] uint64_t timestamp() const noexcept {
+        return timestamp_;
+    }
+    
+    void set_timestamp(uint64_t timestamp) noexcept {
+        timestamp_ = timestamp;
+    }
+    
+private:
+    using BidLevels = PriceLadder<PriceLevel, true>;
+    using AskLevels = PriceLadder<PriceLevel, false>;
+    
+    template<typename Levels>
+    PriceLevel& find_or_add(Levels& levels, uint32_t price) {
+        PriceLevel* level = levels.find(price);
+        if (level == nullptr) {
+            level = level_pool_.create();
+            level->price = price;
+            levels.insert(level);
+        }
+        return *level;
+    }
+    
+    ObjectPool<PriceLevel>& level_pool_;
+    BidLevels bids_;
+    AskLevels asks_;
+    uint64_t timestamp_ = 0;
+    uint16_t stock_locate_;
+};
+
+/**
+ * Update counters for a BookManager
+ */
+struct BookStats {
+    uint64_t adds = 0;
+    uint64_t executions = 0;
+    uint64_t cancels = 0;
+    uint64_t deletes = 0;
+    uint64_t replaces = 0;
+    uint64_t unknown_orders = 0;  // Referenced an order not on the book (joined mid-session)
+    uint64_t duplicate_orders = 0; // Add for a reference already resting
+};
+
+/**
+ * Per-symbol L3 books maintained from parser output
+ * Pass it straight to the parser as a handler: it implements the on_*
+ * callbacks for add (A, F), execute (E, C), cancel (X), delete (D) and
+ * replace (U). Orders are found by reference number in a FlatOrderMap,
+ * and replace keeps the original order's symbol and side, as the spec
+ * requires.
+ *
+ * Books are created on first use and indexed by stock_locate. For more
+ * than one core, run one BookManager per worker of a ShardedPipeline.
+ */
+class BookManager {
+public:
+    static constexpr size_t MAX_LOCATES = 65536;
+    
+    /**
+     * @param expected_orders Live orders to reserve lookup and pool space for
+     */
+    explicit BookManager(size_t expected_orders = 1 << 20);
+    ~BookManager();
+    
+    BookManager(BookManager&&) noexcept = default;
+    BookManager& operator=(BookManager&&) noexcept = default;
+    
+    // Parser handler callbacks
+    void on_stock_directory(const StockDirectoryView& msg) {
+        symbols_.on_stock_directory(msg);
+    }
+    
+    void on_add_order(const AddOrderView& msg) {
+        add(msg.stock_locate(), msg.order_reference_number(), msg.buy_sell_indicator(),
+            msg.shares(), msg.price(), msg.timestamp());
+    }
+    
+    void on_add_order_mpid(const AddOrderMPIDView& msg) {
+        add(msg.stock_locate(), msg.order_reference_number(), msg.buy_sell_indicator(),
+            msg.shares(), msg.price(), msg.timestamp());
+    }
+    
+    void on_execute_order(const ExecuteOrderView& msg) noexcept {
+        ++stats_.executions;
+        reduce(msg.order_reference_number(), msg.executed_shares(), msg.timestamp());
+    }
+    
+    void on_execute_with_price(const ExecuteOrderWithPriceView& msg) noexcept {
+        ++stats_.executions;
+        reduce(msg.order_reference_number(), msg.executed_shares(), msg.timestamp());
+    }
+    
+    void on_order_cancel(const OrderCancelView& msg) noexcept {
+        ++stats_.cancels;
+        reduce(msg.order_reference_number(), msg.cancelled_shares(), msg.timestamp());
+    }
+    
+    void on_order_delete(const OrderDeleteView& msg) noexcept {
+        ++stats_.deletes;
+        BookOrder* order;
+        if (!orders_.extract(msg.order_reference_number(), order)) [[unlikely]] {
+            ++stats_.unknown_orders;
+            return;
+        }
+        OrderBook& book = *books_[order->stock_locate];
+        book.remove(order);
+        updated(book, msg.timestamp());
+        order_pool_.destroy(order);
+    }
+    
+    void on_order_replace(const OrderReplaceView& msg) {
+        ++stats_.replaces;
+        BookOrder* order;
+        if (!orders_.extract(msg.original_order_reference_number(), order)) [[unlikely]] {
+            ++stats_.unknown_orders;
+            return;
+        }
+        
+        // The replacement loses time priority: unlink, re-key, append
+        OrderBook& book = *books_[order->stock_locate];
+        book.remove(order);
+        order->reference = msg.new_order_reference_number();
+        order->price = msg.price();
+        order->shares = msg.shares();
+        if (!orders_.insert(order->reference, order)) [[unlikely]] {
+            ++stats_.duplicate_orders;
+            order_pool_.destroy(order);
+            updated(book, msg.timestamp());
+            return;
+        }
+        book.insert(order);
+        updated(book, msg.timestamp());
+    }
+    
+    /**
+     * Book for a symbol, or nullptr if no order has been seen for it
+     */
+    [[nodiscard]] const OrderBook* book(uint16_t stock_locate) const noexcept {
+        return books_[stock_locate].get();
+    }
+    
+    /**
+     * Symbol from the stock directory, empty if none was seen for the locate
+     */
+    [[nodiscard]] std::string_view symbol(uint16_t stock_locate) const noexcept {
+        return symbols_.symbol(stock_locate);
+    }
+    
+    [[nodiscard]] const SymbolDirectory& symbols() const noexcept {
+        return symbols_;
+    }
+    
+    [[nodiscard]] const BookOrder* find_order(uint64_t reference) const noexcept {
+        BookOrder* const* order = orders_.find(reference);
+        return order != nullptr ? *order : nullptr;
+    }
+    
+    [[nodiscard]] size_t order_count() const noexcept {
+        return orders_.size();
+    }
+    
+    [[nodiscard]] const BookStats& stats() const noexcept {
+        return stats_;
+    }
+    
+    // High-water and slab usage of the order and level pools
+    [[nodiscard]] const PoolStats& order_pool_stats() const noexcept {
+        return order_pool_.stats();
+    }
+    
+    [[nodiscard]] const PoolStats& level_pool_stats() const noexcept {
+        return level_pool_->stats();
+    }
+    
+    /**
+     * Publish every BBO change to a shared table for reader threads
+     * Pass nullptr to stop; the table must outlive the manager.
+     */
+    void set_top_of_book(TopOfBookTable* table) noexcept {
+        top_of_book_ = table;
+    }
+    
+    /**
+     * Drop every order, book and symbol (e.g. at start of day)
+     */
+    void clear();
+    
+private:
+    friend class BookCheckpoint;
+    
+    OrderBook& book_for(uint16_t stock_locate) {
+        auto& slot = books_[stock_locate];
+        if (slot == nullptr) [[unlikely]] {
+            slot = std::make_unique<OrderBook>(stock_locate, *level_pool_);
+        }
+        return *slot;
+    }
+    
+    void updated(OrderBook& book, uint64_t timestamp) noexcept {
+        book.set_timestamp(timestamp);
+        if (top_of_book_ != nullptr) {
+            const BestBidOffer top = book.bbo();
+            top_of_book_->publish(book.stock_locate(), top.bid_price, top.bid_shares,
+                                  top.ask_price, top.ask_shares, timestamp);
+        }
+    }
+    
+    void add(uint16_t stock_locate, uint64_t reference, uint8_t side, uint32_t shares, uint32_t price,
+             uint64_t timestamp) {
+        ++stats_.adds;
+        BookOrder* order = order_pool_.create();
+        order->reference = reference;
+        order->price = price;
+        order->shares = shares;
+        order->stock_locate = stock_locate;
+        order->side = (side == 'S') ? Side::SELL : Side::BUY;
+        if (!orders_.insert(reference, order)) [[unlikely]] {
+            ++stats_.duplicate_orders;
+            order_pool_.destroy(order);
+            return;
+        }
+        
+        OrderBook& book = book_for(stock_locate);
+        book.insert(order);
+        updated(book, timestamp);
+    }
+    
+    void reduce(uint64_t reference, uint32_t shares, uint64_t timestamp) noexcept {
+        BookOrder** found = orders_.find(reference);
+        if (found == nullptr) [[unlikely]] {
+            ++stats_.unknown_orders;
+            return;
+        }
+        BookOrder* order = *found;
+        OrderBook& book = *books_[order->stock_locate];
+        if (book.reduce(order, shares)) {
+            orders_.erase(reference);
+            book.remove(order);
+            order_pool_.destroy(order);
+        }
+        updated(book, timestamp);
+    }
+    
+    FlatOrderMap<BookOrder*> orders_;
+    ObjectPool<BookOrder> order_pool_;
+    // Boxed so books keep a stable reference when the manager moves
+    std::unique_ptr<ObjectPool<PriceLevel>> level_pool_;
+    std::vector<std::unique_ptr<OrderBook>> books_;
+    SymbolDirectory symbols_;
+    TopOfBookTable* top_of_book_ = nullptr;
+    BookStats stats_;
+};
+
+} // namespace fast_market
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "itch_parser.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace fast_market {
+
+/**
+ * One chunk of a parallel parse
+ */
+template<typename Handler>
+struct ChunkResult {
+    size_t begin = 0;   // File offset of the first length prefix
+    size_t end = 0;     // One past the last byte of the chunk
+    BatchResult batch;
+    Handler handler;    // The chunk's own handler instance
+};
+
+/**
+ * Per-chunk results in file order, plus totals
+ */
+template<typename Handler>
+struct ParallelParseResult {
+    std::vector<ChunkResult<Handler>> chunks;
+    BatchResult total;
+    size_t misaligned_chunks = 0;  // Frames did not end exactly on the next boundary
+};
+
+/**
+ * Parallel parser for length-prefixed ITCH files (NASDAQ binary dumps)
+ * The file is mapped, cut into chunks, and each cut is moved forward to
+ * the first offset where RESYNC_CHAIN consecutive frames validate (length
+ * prefix equal to the spec length of the type byte that follows). Chunks
+ * are then parsed on a small pool of threads, each with its own parser and
+ * handler, and returned in file order for the caller to merge.
+ *
+ * Each chunk's parser starts cold: a SymbolFilter that learns locates from
+ * stock directory messages only sees the chunk holding them, so prefer a
+ * ParsedMessage callback or locates known up front.
+ */
+class ParallelFileParser {
+public:
+    // Consecutive valid frames required to accept a boundary
+    static constexpr size_t RESYNC_CHAIN = 16;
+    
+    /**
+     * Map a file for parsing
+     * @param threads Worker count, 0 for one per hardware thread
+     * @throws std::runtime_error if the file cannot be mapped
+     */
+    explicit ParallelFileParser(const std::string& path, size_t threads = 0);
+    
+    /**
+     * Parse a caller-owned buffer instead of a file
+     */
+    ParallelFileParser(const uint8_t* data, size_t size, size_t threads = 0);
+    
+    ~ParallelFileParser();
+    
+    ParallelFileParser(const ParallelFileParser&) = delete;
+    ParallelFileParser& operator=(const ParallelFileParser&) = delete;
+    
+    /**
+     * First frame boundary at or after `from`, or size if there is none
+     * A chain that ends exactly at the end of the buffer is accepted
+     */
+    [[nodiscard]] static size_t find_boundary(const uint8_t* data, size_t size, size_t from) noexcept;
+    
+    /**
+     * Chunk boundaries: count + 1 ascending offsets from 0 to size(), with
+     * empty chunks removed
+     */
+    [[nodiscard]] std::vector<size_t> plan_chunks(size_t count) const;
+    
+    /**
+     * Parse every chunk in parallel
+     * @param make_handler Called as make_handler(chunk_index) to create each
+     *        chunk's handler (a ParsedMessage callable or on_* handler)
+     * @param chunk_count Chunks to cut, 0 for 4 per thread (load balance)
+     */
+    template<typename Parser = ITCHParser, typename MakeHandler>
+    auto parse(MakeHandler&& make_handler, size_t chunk_count = 0)
+        -> ParallelParseResult<std::invoke_result_t<MakeHandler&, size_t>> {
+        using Handler = std::invoke_result_t<MakeHandler&, size_t>;
+        
+        const std::vector<size_t> cuts = plan_chunks(chunk_count ? chunk_count : 4 * threads_);
+        ParallelParseResult<Handler> result;
+        result.chunks.reserve(cuts.size() - 1);
+        for (size_t i = 0; i + 1 < cuts.size(); ++i) {
+            result.chunks.push_back(ChunkResult<Handler>{cuts[i], cuts[i + 1], BatchResult{}, make_handler(i)});
+        }
+        
+        std::atomic<size_t> next_chunk{0};
+        auto worker = [&] {
+            // Parsers carry a 64 KB stream buffer; keep them off the stack
+            auto parser = std::make_unique<Parser>();
+            while (true) {
+                const size_t i = next_chunk.fetch_add(1, std::memory_order_relaxed);
+                if (i >= result.chunks.size()) {
+                    break;
+                }
+                auto& chunk = result.chunks[i];
+                chunk.batch = parser->parse_batch(data_ + chunk.begin, chunk.end - chunk.begin, chunk.handler);
+            }
+        };
+        
+        const size_t workers = std::min(threads_, result.chunks.size());
+        std::vector<std::thread> pool;
+        pool.reserve(workers);
+        for (size_t t = 1; t < workers; ++t) {
+            pool.emplace_back(worker);
+        }
+        worker();  // The calling thread takes a share too
+        for (auto& thread : pool) {
+            thread.join();
+        }
+        
+        for (const auto& chunk : result.chunks) {
+            result.total.bytes_consumed += chunk.batch.bytes_consumed;
+            result.total.messages_parsed += chunk.batch.messages_parsed;
+            result.total.messages_skipped += chunk.batch.messages_skipped;
+            result.total.messages_filtered += chunk.batch.messages_filtered;
+            result.misaligned_chunks += (chunk.batch.bytes_consumed != chunk.end - chunk.begin);
+        }
+        return result;
+    }
+    
+    [[nodiscard]] const uint8_t* data() const noexcept {
+        return data_;
+    }
+    
+    [[nodiscard]] size_t size() const noexcept {
+        return size_;
+    }
+    
+    [[nodiscard]] size_t threads() const noexcept {
+        return threads_;
+    }
+    
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    size_t threads_ = 1;
+    bool mapped_ = false;
+};
+
+} // namespace fast_market
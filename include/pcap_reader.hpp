@@ -0,0 +1,150 @@
+#pragma once
+
+#include "moldudp64.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace fast_market {
+
+/**
+ * UDP datagram found in a capture
+ * payload points into the mapped file and stays valid while the reader lives
+ */
+struct CapturedPacket {
+    uint64_t timestamp_ns = 0;  // Capture time, nanoseconds since the Unix epoch
+    const uint8_t* payload = nullptr;
+    size_t length = 0;
+    uint32_t dst_ipv4 = 0;      // Host order; 0 for IPv6
+    uint16_t src_port = 0;
+    uint16_t dst_port = 0;
+};
+
+/**
+ * Totals for a replay
+ */
+struct ReplayResult {
+    uint64_t packets = 0;       // UDP datagrams handed to the decoder
+    uint64_t gaps = 0;          // Packets that revealed a sequence gap
+    BatchResult batch;          // Summed parser stats
+};
+
+/**
+ * Memory-mapped pcap / pcapng reader
+ * Walks Ethernet (with VLAN tags), Linux cooked or raw IP framing, then
+ * IPv4/IPv6 and UDP headers, and yields the UDP payloads in place. Other
+ * traffic, IP fragments and truncated records are skipped. Both classic
+ * pcap (microsecond or nanosecond, either byte order) and pcapng (enhanced
+ * and simple packet blocks, per-interface timestamp resolution) are
+ * supported.
+ */
+class PcapReader {
+public:
+    enum class Format : uint8_t {
+        PCAP,
+        PCAPNG
+    };
+    
+    /**
+     * Map a capture file
+     * @throws std::runtime_error if the file cannot be mapped or is not a capture
+     */
+    explicit PcapReader(const std::string& path);
+    ~PcapReader();
+    
+    PcapReader(const PcapReader&) = delete;
+    PcapReader& operator=(const PcapReader&) = delete;
+    
+    /**
+     * Advance to the next UDP datagram
+     * @return false at end of file
+     */
+    bool next(CapturedPacket& packet) noexcept;
+    
+    /**
+     * Only yield datagrams sent to this UDP port (0 for all)
+     */
+    void set_port_filter(uint16_t dst_port) noexcept {
+        port_filter_ = dst_port;
+    }
+    
+    /**
+     * Start again from the first record
+     */
+    void rewind() noexcept;
+    
+    /**
+     * Feed every MoldUDP64 datagram through a decoder into the parser
+     * While the handler runs, capture_timestamp_ns() is the capture time of
+     * the packet its message came in
+     */
+    template<typename Parser, typename Handler>
+    ReplayResult replay(MoldUDP64Decoder& decoder, Parser& parser, Handler&& handler) noexcept {
+        ReplayResult result;
+        CapturedPacket packet;
+        while (next(packet)) {
+            capture_timestamp_ns_ = packet.timestamp_ns;
+            const PacketResult r = decoder.process(packet.payload, packet.length, parser, handler);
+            ++result.packets;
+            result.gaps += r.has_gap();
+            result.batch.bytes_consumed += r.batch.bytes_consumed;
+            result.batch.messages_parsed += r.batch.messages_parsed;
+            result.batch.messages_skipped += r.batch.messages_skipped;
+            result.batch.messages_filtered += r.batch.messages_filtered;
+        }
+        return result;
+    }
+    
+    [[nodiscard]] uint64_t capture_timestamp_ns() const noexcept {
+        return capture_timestamp_ns_;
+    }
+    
+    [[nodiscard]] Format format() const noexcept {
+        return format_;
+    }
+    
+    // Records walked that did not yield a datagram
+    [[nodiscard]] uint64_t records_skipped() const noexcept {
+        return records_skipped_;
+    }
+    
+private:
+    // One captured frame before link/IP/UDP decoding
+    struct Frame {
+        const uint8_t* data;
+        size_t length;
+        uint64_t timestamp_ns;
+        uint16_t link_type;
+    };
+    
+    bool next_pcap_frame(Frame& frame) noexcept;
+    bool next_pcapng_frame(Frame& frame) noexcept;
+    bool extract_udp(const Frame& frame, CapturedPacket& packet) const noexcept;
+    
+    uint16_t read16(const uint8_t* p) const noexcept;
+    uint32_t read32(const uint8_t* p) const noexcept;
+    
+    static constexpr size_t MAX_INTERFACES = 16;
+    
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    size_t offset_ = 0;
+    size_t first_record_ = 0;
+    Format format_ = Format::PCAP;
+    bool swapped_ = false;          // File byte order differs from host
+    
+    // Classic pcap
+    uint16_t link_type_ = 0;
+    uint64_t ts_fraction_ns_ = 1000;  // Nanoseconds per sub-second unit
+    
+    // pcapng, per interface in the current section
+    uint16_t if_link_type_[MAX_INTERFACES] = {};
+    uint64_t if_ticks_per_second_[MAX_INTERFACES] = {};
+    size_t interface_count_ = 0;
+    
+    uint16_t port_filter_ = 0;
+    uint64_t capture_timestamp_ns_ = 0;
+    uint64_t records_skipped_ = 0;
+};
+
+} // namespace fast_market
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <type_traits>
+
+namespace fast_market {
+
+/**
+ * Price levels of one book side, indexed by tick offset from an anchor
+ * Prices are ITCH fixed-point (4 decimals) and cluster in a narrow band
+ * around the touch, so levels on the tick grid within WINDOW_TICKS of the
+ * anchor live in a flat array. A two-level occupancy bitmap (one bit per
+ * slot, one summary bit per 64-slot word) finds the best level with two
+ * tzcnt/lzcnt instructions, so dropping the best level is constant time.
+ *
+ * Prices outside the window or off the grid (sub-penny quotes) go to a
+ * sorted fallback map. When a new best lands beyond the window, or the
+ * window has emptied, the anchor slides: the window is re-centred on the
+ * new price and levels are moved between the array and the fallback.
+ *
+ * Level is any type with a uint32_t `price` member; the ladder stores
+ * pointers and never owns them. Descending orders bids (best = highest).
+ */
+template<typename Level, bool Descending>
+class PriceLadder {
+public:
+    static constexpr size_t WINDOW_TICKS = 512;
+    static constexpr uint32_t PENNY_TICK = 100;  // $0.01 in ITCH price units
+    
+    PriceLadder() = default;
+    
+    PriceLadder(const PriceLadder&) = delete;
+    PriceLadder& operator=(const PriceLadder&) = delete;
+    
+    /**
+     * @return Level resting at price, or nullptr
+     */
+    [[nodiscard]] Level* find(uint32_t price) const noexcept {
+        const size_t slot = slot_of(price);
+        if (slot != NO_SLOT) [[likely]] {
+            return slots_[slot];
+        }
+        if (outliers_.empty()) [[likely]] {
+            return nullptr;
+        }
+        const auto it = outliers_.find(price);
+        return it != outliers_.end() ? it->second : nullptr;
+    }
+    
+    /**
+     * Add a level whose price is not on the ladder yet
+     */
+    void insert(Level* level) {
+        const uint32_t price = level->price;
+        size_t slot = slot_of(price);
+        if (slot == NO_SLOT) [[unlikely]] {
+            if (should_reanchor(price)) {
+                reanchor(price);
+                slot = slot_of(price);
+            }
+            if (slot == NO_SLOT) {
+                outliers_.emplace(price, level);
+            }
+        }
+        if (slot != NO_SLOT) [[likely]] {
+            occupy(slot, level);
+        }
+        if (best_ == nullptr || better(price, best_->price)) {
+            best_ = level;
+        }
+    }
+    
+    /**
+     * Take a level off the ladder
+     */
+    void erase(Level* level) noexcept {
+        const size_t slot = slot_of(level->price);
+        if (slot != NO_SLOT) [[likely]] {
+            vacate(slot);
+        } else {
+            outliers_.erase(level->price);
+        }
+        if (level == best_) {
+            best_ = find_best();
+        }
+    }
+    
+    [[nodiscard]] Level* best() const noexcept {
+        return best_;
+    }
+    
+    [[nodiscard]] size_t size() const noexcept {
+        return window_count_ + outliers_.size();
+    }
+    
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+    
+    // Levels held in the fallback map rather than the window
+    [[nodiscard]] size_t outlier_count() const noexcept {
+        return outliers_.size();
+    }
+    
+    // Times the window has been re-centred
+    [[nodiscard]] uint64_t reanchors() const noexcept {
+        return reanchors_;
+    }
+    
+    /**
+     * Visit levels from the best price outwards until fn returns false
+     */
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        auto outlier = outliers_.begin();
+        const bool finished = for_each_in_window([&](const Level& level) {
+            for (; outlier != outliers_.end() && better(outlier->first, level.price); ++outlier) {
+                if (!fn(*outlier->second)) {
+                    return false;
+                }
+            }
+            return fn(level);
+        });
+        if (!finished) {
+            return;
+        }
+        for (; outlier != outliers_.end(); ++outlier) {
+            if (!fn(*outlier->second)) {
+                return;
+            }
+        }
+    }
+    
+private:
+    static constexpr size_t WORD_BITS = 64;
+    static constexpr size_t WORDS = WINDOW_TICKS / WORD_BITS;
+    static constexpr size_t NO_SLOT = SIZE_MAX;
+    static_assert(WINDOW_TICKS % WORD_BITS == 0 && WORDS <= WORD_BITS, "Summary word covers every bitmap word");
+    
+    using Compare = std::conditional_t<Descending, std::greater<uint32_t>, std::less<uint32_t>>;
+    
+    static bool better(uint32_t a, uint32_t b) noexcept {
+        return Compare{}(a, b);
+    }
+    
+    [[gnu::always_inline]] size_t slot_of(uint32_t price) const noexcept {
+        const uint32_t delta = price - base_;  // Wraps below the window
+        // Constant divisor in the common case, so no hardware divide
+        const uint32_t offset = (tick_ == PENNY_TICK) ? delta / PENNY_TICK : delta;
+        if (offset >= WINDOW_TICKS || offset * tick_ != delta) {
+            return NO_SLOT;
+        }
+        return offset;
+    }
+    
+    void occupy(size_t slot, Level* level) noexcept {
+        slots_[slot] = level;
+        words_[slot / WORD_BITS] |= uint64_t{1} << (slot % WORD_BITS);
+        summary_ |= uint64_t{1} << (slot / WORD_BITS);
+        ++window_count_;
+    }
+    
+    void vacate(size_t slot) noexcept {
+        slots_[slot] = nullptr;
+        uint64_t& word = words_[slot / WORD_BITS];
+        word &= ~(uint64_t{1} << (slot % WORD_BITS));
+        if (word == 0) {
+            summary_ &= ~(uint64_t{1} << (slot / WORD_BITS));
+        }
+        --window_count_;
+    }
+    
+    // Best occupied slot: highest for bids, lowest for asks
+    [[nodiscard]] Level* window_best() const noexcept {
+        if (summary_ == 0) {
+            return nullptr;
+        }
+        size_t word;
+        size_t bit;
+        if constexpr (Descending) {
+            word = WORD_BITS - 1 - std::countl_zero(summary_);
+            bit = WORD_BITS - 1 - std::countl_zero(words_[word]);
+        } else {
+            word = std::countr_zero(summary_);
+            bit = std::countr_zero(words_[word]);
+        }
+        return slots_[word * WORD_BITS + bit];
+    }
+    
+    [[nodiscard]] Level* find_best() const noexcept {
+        Level* best = window_best();
+        if (!outliers_.empty()) [[unlikely]] {
+            Level* outlier = outliers_.begin()->second;
+            if (best == nullptr || better(outlier->price, best->price)) {
+                best = outlier;
+            }
+        }
+        return best;
+    }
+    
+    // Slide when the window is unused, or when the touch has moved past
+    // its better edge; prices beyond the worse edge are deep book
+    [[nodiscard]] bool should_reanchor(uint32_t price) const noexcept {
+        if (window_count_ == 0) {
+            return true;
+        }
+        if (price % tick_ != base_ % tick_) {
+            return false;  // Off the grid: re-centring would not place it
+        }
+        // On the grid but not in the window: above it or below it
+        return Descending ? price >= base_ : price < base_;
+    }
+    
+    // Re-centre the window on price, exchanging levels with the fallback
+    [[gnu::noinline]] void reanchor(uint32_t price) {
+        ++reanchors_;
+        for (uint64_t summary = summary_; summary != 0; summary &= summary - 1) {
+            const size_t word = std::countr_zero(summary);
+            for (uint64_t bits = words_[word]; bits != 0; bits &= bits - 1) {
+                const size_t slot = word * WORD_BITS + std::countr_zero(bits);
+                outliers_.emplace(slots_[slot]->price, slots_[slot]);
+                slots_[slot] = nullptr;
+            }
+            words_[word] = 0;
+        }
+        summary_ = 0;
+        window_count_ = 0;
+        
+        // Penny grid for whole-cent prices, otherwise every price unit
+        tick_ = (price % PENNY_TICK == 0) ? PENNY_TICK : 1;
+        const uint32_t below = std::min<uint32_t>(price / tick_, WINDOW_TICKS / 2);
+        base_ = price - below * tick_;
+        
+        for (auto it = outliers_.begin(); it != outliers_.end();) {
+            const size_t slot = slot_of(it->first);
+            if (slot != NO_SLOT) {
+                occupy(slot, it->second);
+                it = outliers_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    
+    // Window levels from best outwards; false if fn stopped early
+    template<typename Fn>
+    bool for_each_in_window(Fn&& fn) const {
+        if constexpr (Descending) {
+            for (size_t word = WORDS; word-- > 0;) {
+                for (uint64_t bits = words_[word]; bits != 0;) {
+                    const size_t bit = WORD_BITS - 1 - std::countl_zero(bits);
+                    bits &= ~(uint64_t{1} << bit);
+                    if (!fn(*slots_[word * WORD_BITS + bit])) {
+                        return false;
+                    }
+                }
+            }
+        } else {
+            for (size_t word = 0; word < WORDS; ++word) {
+                for (uint64_t bits = words_[word]; bits != 0; bits &= bits - 1) {
+                    if (!fn(*slots_[word * WORD_BITS + std::countr_zero(bits)])) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+    
+    Level* best_ = nullptr;
+    uint32_t base_ = 0;                 // Price of slot 0
+    uint32_t tick_ = PENNY_TICK;        // Price step between slots
+    size_t window_count_ = 0;
+    uint64_t summary_ = 0;              // Bit w set when words_[w] != 0
+    uint64_t words_[WORDS] = {};
+    uint64_t reanchors_ = 0;
+    std::map<uint32_t, Level*, Compare> outliers_;
+    Level* slots_[WINDOW_TICKS] = {};
+};
+
+} // namespace fast_market
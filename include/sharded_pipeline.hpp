@@ -0,0 +1,250 @@
+#pragma once
+
+#include "itch_parser.hpp"
+#include "mpmc_queue.hpp"
+#include "system_utils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace fast_market {
+
+/**
+ * One routed message, copied into a cache-line slot of a shard's ring
+ */
+struct alignas(CACHE_LINE_SIZE) ShardSlot {
+    uint8_t length;
+    uint8_t data[CACHE_LINE_SIZE - 1];
+};
+
+static_assert(*std::max_element(MESSAGE_LENGTHS.begin(), MESSAGE_LENGTHS.end()) <= sizeof(ShardSlot::data),
+              "Every ITCH message must fit in one shard slot");
+
+/**
+ * Router-side counters
+ */
+struct RouteStats {
+    uint64_t routed = 0;        // Messages pushed to one shard
+    uint64_t broadcast = 0;     // Locate 0 (market-wide) messages pushed to every shard
+    uint64_t invalid = 0;       // Length did not match the type byte
+    uint64_t stalls = 0;        // Pushes that found the target ring full
+    uint64_t dropped = 0;       // Routed after finish(), with no worker left to drain
+};
+
+/**
+ * Pipeline stage that partitions the stream by symbol across worker threads
+ * The router reads each message's stock_locate and copies the raw message
+ * into the owning worker's SPSC ring; decoding happens on the worker, with
+ * its own parser and handler. A symbol always maps to the same worker, so
+ * per-symbol order is preserved and per-symbol state (books, bars) needs
+ * no locking. Locate 0 messages (system events, MWCB) are market-wide and
+ * go to every worker, in order with that worker's other traffic.
+ *
+ * route() is called from a single router thread. Handlers must be left
+ * alone until finish() has joined the workers.
+ */
+template<typename Handler, typename Parser = ITCHParser, size_t RingCapacity = 16384>
+class ShardedPipeline {
+public:
+    // Busy polls before an idle side starts yielding its core
+    static constexpr unsigned SPIN_LIMIT = 1024;
+    
+    /**
+     * Start the workers
+     * @param make_handler Called as make_handler(shard) to create each worker's handler
+     * @param cores Core for each worker (worker i uses cores[i % size]); empty to leave placement to the OS
+     */
+    template<typename MakeHandler>
+    ShardedPipeline(size_t workers, MakeHandler&& make_handler, const std::vector<int>& cores = {})
+        : cores_(cores)
+    {
+        shards_.reserve(std::max<size_t>(workers, 1));
+        for (size_t i = 0; i < std::max<size_t>(workers, 1); ++i) {
+            shards_.push_back(std::make_unique<Shard>(make_handler(i)));
+        }
+        for (size_t i = 0; i < shards_.size(); ++i) {
+            shards_[i]->thread = std::thread([this, i] { run_shard(*shards_[i], i); });
+        }
+    }
+    
+    ~ShardedPipeline() {
+        finish();
+    }
+    
+    ShardedPipeline(const ShardedPipeline&) = delete;
+    ShardedPipeline& operator=(const ShardedPipeline&) = delete;
+    
+    [[nodiscard]] size_t shard_of(uint16_t stock_locate) const noexcept {
+        return stock_locate % shards_.size();
+    }
+    
+    /**
+     * Route one ITCH message (no length prefix), waiting if the target ring is full
+     * @return false if the message is malformed or finish() has been called
+     *         (it is dropped)
+     */
+    bool route(const uint8_t* data, size_t length) noexcept {
+        if (stopping_.load(std::memory_order_relaxed)) [[unlikely]] {
+            ++stats_.dropped;
+            return false;
+        }
+        if (length < sizeof(ITCHMessageHeader) || length != MESSAGE_LENGTHS[data[0]]) [[unlikely]] {
+            ++stats_.invalid;
+            return false;
+        }
+        
+        uint16_t locate;
+        std::memcpy(&locate, data + 1, sizeof(locate));
+        locate = ntoh16(locate);
+        if (locate == 0) [[unlikely]] {
+            for (auto& shard : shards_) {
+                push(*shard, data, length);
+            }
+            ++stats_.broadcast;
+            return true;
+        }
+        
+        push(*shards_[shard_of(locate)], data, length);
+        ++stats_.routed;
+        return true;
+    }
+    
+    /**
+     * Route a buffer of complete length-prefixed frames
+     * @return messages_parsed counts routed messages, messages_skipped malformed
+     *         or dropped ones
+     */
+    BatchResult route_batch(const uint8_t* data, size_t length) noexcept {
+        BatchResult result;
+        size_t offset = 0;
+        
+        while (offset + Parser::FRAME_PREFIX_SIZE <= length) {
+            const size_t msg_len = Parser::read_frame_length(data + offset);
+            const size_t frame_len = Parser::FRAME_PREFIX_SIZE + msg_len;
+            if (offset + frame_len > length) [[unlikely]] {
+                break;
+            }
+            
+            if (route(data + offset + Parser::FRAME_PREFIX_SIZE, msg_len)) [[likely]] {
+                ++result.messages_parsed;
+            } else {
+                ++result.messages_skipped;
+            }
+            offset += frame_len;
+        }
+        
+        result.bytes_consumed = offset;
+        return result;
+    }
+    
+    /**
+     * Drain every ring and join the workers; later calls do nothing
+     * Messages routed afterwards are dropped
+     */
+    void finish() {
+        stopping_.store(true, std::memory_order_release);
+        for (auto& shard : shards_) {
+            if (shard->thread.joinable()) {
+                shard->thread.join();
+            }
+        }
+    }
+    
+    [[nodiscard]] size_t workers() const noexcept {
+        return shards_.size();
+    }
+    
+    // Only after finish()
+    [[nodiscard]] Handler& handler(size_t shard) noexcept {
+        return shards_[shard]->handler;
+    }
+    
+    // Worker-side parser results, only after finish()
+    [[nodiscard]] const BatchResult& result(size_t shard) const noexcept {
+        return shards_[shard]->result;
+    }
+    
+    [[nodiscard]] const RouteStats& stats() const noexcept {
+        return stats_;
+    }
+    
+private:
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        explicit Shard(Handler&& h) : handler(std::move(h)) {}
+        
+        SPSCQueue<ShardSlot, RingCapacity> ring;
+        Handler handler;
+        BatchResult result;
+        std::thread thread;
+    };
+    
+    static void backoff(unsigned& idle) noexcept {
+        if (++idle < SPIN_LIMIT) {
+            SystemUtils::cpu_pause();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    
+    [[gnu::always_inline]]
+    void push(Shard& shard, const uint8_t* data, size_t length) noexcept {
+        ShardSlot* slot = shard.ring.producer_slot();
+        if (slot == nullptr) [[unlikely]] {
+            ++stats_.stalls;
+            unsigned idle = 0;
+            do {
+                backoff(idle);
+                slot = shard.ring.producer_slot();
+            } while (slot == nullptr);
+        }
+        slot->length = static_cast<uint8_t>(length);
+        std::memcpy(slot->data, data, length);
+        shard.ring.publish();
+    }
+    
+    void run_shard(Shard& shard, size_t index) noexcept {
+        std::optional<ScopedCPUPin> pin;
+        if (!cores_.empty()) {
+            pin.emplace(cores_[index % cores_.size()]);
+        }
+        
+        // Parsers carry a 64 KB stream buffer; keep them off the stack
+        auto parser = std::make_unique<Parser>();
+        unsigned idle = 1;
+        while (true) {
+            const ShardSlot* slot = shard.ring.front();
+            if (slot != nullptr) [[likely]] {
+                // Each run of messages after an idle spell is one batch
+                if (idle != 0) {
+                    parser->begin_batch();
+                    idle = 0;
+                }
+                parser->parse_batch_message(slot->data, slot->length, shard.handler, shard.result);
+                shard.ring.pop();
+                continue;
+            }
+            
+            // Everything published before stopping_ is visible once it is seen
+            if (stopping_.load(std::memory_order_acquire)) {
+                if (shard.ring.front() == nullptr) {
+                    break;
+                }
+                continue;
+            }
+            backoff(idle);
+        }
+    }
+    
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::vector<int> cores_;
+    RouteStats stats_;
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> stopping_{false};
+};
+
+} // namespace fast_market
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "itch_parser.hpp"
+#include "mirrored_ring.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace fast_market {
+
+/**
+ * SoupBinTCP 3.0 packet types
+ * Every packet is a 2-byte big-endian length (covering the type byte and
+ * payload), the type byte, then the payload
+ */
+enum class SoupPacketType : uint8_t {
+    // Server to client
+    DEBUG = '+',
+    LOGIN_ACCEPTED = 'A',
+    LOGIN_REJECTED = 'J',
+    SEQUENCED_DATA = 'S',
+    SERVER_HEARTBEAT = 'H',
+    END_OF_SESSION = 'Z',
+    
+    // Client to server
+    LOGIN_REQUEST = 'L',
+    UNSEQUENCED_DATA = 'U',
+    CLIENT_HEARTBEAT = 'R',
+    LOGOUT_REQUEST = 'O'
+};
+
+/**
+ * Non-blocking SoupBinTCP client session for replay and snapshot feeds
+ * Socket reads land in a MirroredRingBuffer and packets are framed in
+ * place, including ones that wrap the end of the ring, so there is no
+ * per-packet allocation, copy or memmove. Each poll() hands every complete
+ * sequenced data packet to the parser as one batch.
+ *
+ * connect()/attach()/login() are setup calls and throw on failure; poll()
+ * never throws and reports connection loss through state().
+ */
+class SoupBinTCPSession {
+public:
+    static constexpr size_t PACKET_PREFIX_SIZE = 2;
+    static constexpr size_t DEFAULT_RING_SIZE = 4 * 1024 * 1024;
+    // Two maximum-size packets, so a partial packet never fills the ring
+    static constexpr size_t MIN_RING_SIZE = 2 * (PACKET_PREFIX_SIZE + UINT16_MAX);
+    // Client heartbeat interval required by the protocol
+    static constexpr uint64_t HEARTBEAT_INTERVAL_NS = 1000000000ULL;
+    
+    enum class State : uint8_t {
+        DISCONNECTED,
+        LOGIN_PENDING,
+        ACTIVE,
+        REJECTED,   // See reject_reason()
+        ENDED       // Server sent end of session
+    };
+    
+    explicit SoupBinTCPSession(size_t ring_size = DEFAULT_RING_SIZE);
+    ~SoupBinTCPSession();
+    
+    SoupBinTCPSession(const SoupBinTCPSession&) = delete;
+    SoupBinTCPSession& operator=(const SoupBinTCPSession&) = delete;
+    
+    /**
+     * Connect to a server (blocking), then switch the socket to non-blocking
+     * @throws std::runtime_error on resolution or connection failure
+     */
+    void connect(const std::string& host, uint16_t port);
+    
+    /**
+     * Take ownership of an already connected socket
+     */
+    void attach(int fd);
+    
+    /**
+     * Send a login request
+     * @param session Requested session, blank for the current one
+     * @param sequence First sequence number wanted, 0 for the live edge
+     * @throws std::runtime_error if the request cannot be sent
+     */
+    void login(std::string_view username, std::string_view password,
+               std::string_view session = {}, uint64_t sequence = 1);
+    
+    /**
+     * Send a logout request; the server then closes the connection
+     */
+    void logout() noexcept;
+    
+    /**
+     * Read what the socket has and process every complete packet
+     * @param parser Any BasicITCHParser
+     * @param handler Passed through to the parser for sequenced data
+     * @return Parser stats for this poll; bytes_consumed counts ring bytes
+     */
+    template<typename Parser, typename Handler>
+    BatchResult poll(Parser& parser, Handler&& handler) noexcept {
+        if (fd_ >= 0) {
+            receive();
+        }
+        
+        BatchResult result;
+        const uint8_t* data = ring_.read_ptr();
+        const size_t available = ring_.readable();
+        size_t offset = 0;
+        
+        parser.begin_batch();
+        while (offset + PACKET_PREFIX_SIZE < available) {
+            const size_t packet_len = Parser::read_frame_length(data + offset);
+            const size_t frame_len = PACKET_PREFIX_SIZE + packet_len;
+            if (offset + frame_len > available) {
+                break;
+            }
+            
+            const uint8_t* packet = data + offset + PACKET_PREFIX_SIZE;
+            if (packet_len > 0 && packet[0] == static_cast<uint8_t>(SoupPacketType::SEQUENCED_DATA)) [[likely]] {
+                parser.parse_batch_message(packet + 1, packet_len - 1, handler, result);
+                ++next_sequence_;
+            } else if (packet_len > 0) {
+                handle_control(static_cast<SoupPacketType>(packet[0]), packet + 1, packet_len - 1);
+            }
+            offset += frame_len;
+        }
+        
+        ring_.consume(offset);
+        result.bytes_consumed = offset;
+        
+        if (state_ == State::ACTIVE) {
+            service_heartbeat();
+        }
+        return result;
+    }
+    
+    [[nodiscard]] State state() const noexcept {
+        return state_;
+    }
+    
+    // Sequence number of the next sequenced data packet
+    [[nodiscard]] uint64_t next_sequence() const noexcept {
+        return next_sequence_;
+    }
+    
+    [[nodiscard]] const std::array<char, 10>& session() const noexcept {
+        return session_;
+    }
+    
+    // 'A' not authorized, 'S' session not available
+    [[nodiscard]] char reject_reason() const noexcept {
+        return reject_reason_;
+    }
+    
+    [[nodiscard]] int fd() const noexcept {
+        return fd_;
+    }
+    
+    [[nodiscard]] size_t buffered_bytes() const noexcept {
+        return ring_.readable();
+    }
+    
+private:
+    void receive() noexcept;
+    void handle_control(SoupPacketType type, const uint8_t* payload, size_t length) noexcept;
+    void service_heartbeat() noexcept;
+    bool send_packet(SoupPacketType type, const char* payload, size_t length) noexcept;
+    void close_socket() noexcept;
+    
+    MirroredRingBuffer ring_;
+    int fd_ = -1;
+    State state_ = State::DISCONNECTED;
+    std::array<char, 10> session_{};
+    uint64_t next_sequence_ = 0;
+    uint64_t last_send_ns_ = 0;
+    char reject_reason_ = ' ';
+};
+
+} // namespace fast_market
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "itch_views.hpp"
+#include "flat_order_map.hpp"
+#include "symbol_filter.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace fast_market {
+
+/**
+ * Stock directory entry for one stock_locate, decoded once
+ * The symbol is kept with its trimmed length, so reading it needs no
+ * scan for padding.
+ */
+struct SymbolInfo {
+    std::array<char, 8> stock{};        // Space-padded as on the wire
+    uint32_t round_lot_size = 0;
+    uint32_t etp_leverage_factor = 0;
+    uint8_t symbol_length = 0;          // 0 = no directory entry for this locate
+    uint8_t market_category = 0;
+    uint8_t financial_status_indicator = 0;
+    uint8_t round_lots_only = 0;
+    uint8_t issue_classification = 0;
+    std::array<char, 2> issue_sub_type{};
+    uint8_t authenticity = 0;
+    uint8_t short_sale_threshold_indicator = 0;
+    uint8_t ipo_flag = 0;
+    uint8_t luld_reference_price_tier = 0;
+    uint8_t etp_flag = 0;
+    uint8_t inverse_indicator = 0;
+    
+    [[nodiscard]] std::string_view symbol() const noexcept {
+        return std::string_view(stock.data(), symbol_length);
+    }
+};
+
+/**
+ * Symbol metadata indexed by stock_locate, filled from stock directory (R)
+ * messages
+ * Pass it to the parser as a handler, or call add() directly. Entries sit
+ * in a dense array, so locate -> symbol is a single indexed load. The
+ * reverse symbol -> locate lookup treats the 8-byte padded symbol as a
+ * uint64_t key in a FlatOrderMap (SSE2-probed), so it is one hash and
+ * usually one tag compare, with no string handling.
+ *
+ * Writes are not synchronized: fill it on one thread (normally before
+ * the session opens) and read it from others afterwards.
+ */
+class SymbolDirectory {
+public:
+    static constexpr size_t MAX_LOCATES = 65536;
+    
+    SymbolDirectory();
+    
+    SymbolDirectory(SymbolDirectory&&) noexcept = default;
+    SymbolDirectory& operator=(SymbolDirectory&&) noexcept = default;
+    
+    // Parser handler callback
+    void on_stock_directory(const StockDirectoryView& msg);
+    
+    /**
+     * Record (or replace) the entry for a locate
+     * A symbol that moves to another locate is re-pointed there.
+     */
+    void add(uint16_t stock_locate, const SymbolInfo& info);
+    
+    /**
+     * Entry for a locate, or nullptr if no directory message named it
+     */
+    [[nodiscard]] const SymbolInfo* find(uint16_t stock_locate) const noexcept {
+        const SymbolInfo& info = entries_[stock_locate];
+        return info.symbol_length != 0 ? &info : nullptr;
+    }
+    
+    /**
+     * Trimmed symbol, empty if the locate is unknown
+     */
+    [[nodiscard]] std::string_view symbol(uint16_t stock_locate) const noexcept {
+        return entries_[stock_locate].symbol();
+    }
+    
+    /**
+     * Locate for a symbol, or 0 (never a stock) if it is not listed
+     */
+    [[nodiscard]] uint16_t locate(std::string_view symbol) const noexcept {
+        return locate_of_key(symbol_key(symbol));
+    }
+    
+    [[nodiscard]] uint16_t locate(const std::array<char, 8>& stock) const noexcept {
+        return locate_of_key(symbol_key(stock));
+    }
+    
+    /**
+     * Visit every listed symbol as fn(stock_locate, info), in locate order
+     */
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        for (size_t locate = 0; locate < entries_.size(); ++locate) {
+            if (entries_[locate].symbol_length != 0) {
+                fn(static_cast<uint16_t>(locate), entries_[locate]);
+            }
+        }
+    }
+    
+    [[nodiscard]] size_t size() const noexcept {
+        return by_symbol_.size();
+    }
+    
+    void clear();
+    
+private:
+    [[nodiscard]] uint16_t locate_of_key(uint64_t key) const noexcept {
+        const uint16_t* locate = by_symbol_.find(key);
+        return locate != nullptr ? *locate : 0;
+    }
+    
+    std::vector<SymbolInfo> entries_;
+    FlatOrderMap<uint16_t> by_symbol_;
+};
+
+} // namespace fast_market
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "itch_protocol.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace fast_market {
+
+/**
+ * Pack an 8-byte space-padded ITCH symbol into an integer key
+ */
+[[gnu::always_inline]] inline uint64_t symbol_key(const std::array<char, 8>& stock) noexcept {
+    uint64_t key;
+    std::memcpy(&key, stock.data(), sizeof(key));
+    return key;
+}
+
+/**
+ * Key for a symbol given as text (padded to 8 characters, truncated beyond)
+ */
+inline uint64_t symbol_key(std::string_view symbol) noexcept {
+    std::array<char, 8> stock;
+    stock.fill(' ');
+    std::memcpy(stock.data(), symbol.data(), std::min(symbol.size(), stock.size()));
+    return symbol_key(stock);
+}
+
+/**
+ * Per-symbol subscription filter keyed on stock_locate
+ * Holds a 65,536-bit bitmap with one bit per locate code, so a message is
+ * accepted or rejected from the 3 header bytes before anything is decoded.
+ * Bits are set from stock directory messages whose symbol was subscribed;
+ * locate 0 (market-wide messages) always passes. Locates enabled directly
+ * with allow_locate() stay enabled until block_locate(), whatever the
+ * directory says about their symbol.
+ *
+ * accepts() is a lock-free relaxed load. Subscriptions can be changed from
+ * any thread while a parser is running; the change applies to the next
+ * message checked.
+ */
+class SymbolFilter {
+public:
+    static constexpr size_t LOCATE_COUNT = 65536;
+    
+    SymbolFilter() noexcept;
+    
+    SymbolFilter(const SymbolFilter&) = delete;
+    SymbolFilter& operator=(const SymbolFilter&) = delete;
+    
+    /**
+     * Accept messages for a symbol
+     * Takes effect immediately if its locate is already known, otherwise
+     * when its stock directory message arrives
+     */
+    void subscribe(std::string_view symbol);
+    
+    /**
+     * Stop accepting messages for a symbol
+     */
+    void unsubscribe(std::string_view symbol);
+    
+    /**
+     * Record a locate-to-symbol mapping (normally from a stock directory
+     * message) and enable the locate if the symbol is subscribed
+     */
+    void learn(uint16_t stock_locate, const std::array<char, 8>& stock);
+    
+    /**
+     * Enable or disable a locate code directly, bypassing symbol names
+     * An allowed locate is pinned: stock directory messages and
+     * unsubscribe() no longer disable it, only block_locate() does
+     */
+    void allow_locate(uint16_t stock_locate) noexcept {
+        pinned_[stock_locate >> 6].fetch_or(bit(stock_locate), std::memory_order_relaxed);
+        enable(stock_locate);
+    }
+    
+    void block_locate(uint16_t stock_locate) noexcept {
+        if (stock_locate != 0) {
+            pinned_[stock_locate >> 6].fetch_and(~bit(stock_locate), std::memory_order_relaxed);
+            word(stock_locate).fetch_and(~bit(stock_locate), std::memory_order_relaxed);
+        }
+    }
+    
+    [[nodiscard]] bool accepts(uint16_t stock_locate) const noexcept {
+        return (word(stock_locate).load(std::memory_order_relaxed) & bit(stock_locate)) != 0;
+    }
+    
+    /**
+     * Parser filter stage over a length-validated message
+     * Stock directory messages are learned before being checked
+     */
+    [[gnu::always_inline]] bool admit(const uint8_t* data) {
+        uint16_t locate;
+        std::memcpy(&locate, data + 1, sizeof(locate));
+        locate = ntoh16(locate);
+        
+        if (data[0] == static_cast<uint8_t>(MessageType::STOCK_DIRECTORY)) [[unlikely]] {
+            learn(locate, reinterpret_cast<const StockDirectoryMessage*>(data)->stock);
+        }
+        return accepts(locate);
+    }
+    
+    /**
+     * Number of locates currently enabled (including locate 0)
+     */
+    [[nodiscard]] size_t accepted_count() const noexcept;
+    
+private:
+    static constexpr uint64_t bit(uint16_t stock_locate) noexcept {
+        return uint64_t{1} << (stock_locate & 63);
+    }
+    
+    std::atomic<uint64_t>& word(uint16_t stock_locate) noexcept {
+        return bitmap_[stock_locate >> 6];
+    }
+    
+    const std::atomic<uint64_t>& word(uint16_t stock_locate) const noexcept {
+        return bitmap_[stock_locate >> 6];
+    }
+    
+    // Symbol-driven changes, which leave pinned locates alone
+    void enable(uint16_t stock_locate) noexcept {
+        word(stock_locate).fetch_or(bit(stock_locate), std::memory_order_relaxed);
+    }
+    
+    void release(uint16_t stock_locate) noexcept {
+        const bool pinned = (pinned_[stock_locate >> 6].load(std::memory_order_relaxed) & bit(stock_locate)) != 0;
+        if (!pinned && stock_locate != 0) {
+            word(stock_locate).fetch_and(~bit(stock_locate), std::memory_order_relaxed);
+        }
+    }
+    
+    // 8 KB, one bit per locate
+    std::array<std::atomic<uint64_t>, LOCATE_COUNT / 64> bitmap_;
+    
+    // Locates enabled through allow_locate(), same layout; not read per message
+    std::array<std::atomic<uint64_t>, LOCATE_COUNT / 64> pinned_;
+    
+    // Symbol bookkeeping, off the hot path
+    std::mutex mutex_;
+    std::unordered_set<uint64_t> subscribed_;
+    std::unordered_map<uint64_t, uint16_t> locates_;  // Symbol key -> locate
+};
+
+} // namespace fast_market
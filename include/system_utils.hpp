@@ -8,6 +8,7 @@
 #include <fstream>
 #include <stdexcept>
 #include <cstdint>
+#include <cstddef>
 
 namespace fast_market {
 
@@ -152,6 +153,54 @@ public:
         }
     }
     
+    /**
+     * Allocate a large zeroed region, on huge pages when the system has
+     * them reserved, otherwise on normal pages advised for transparent huge
+     * pages. Sizes of 2 MB and up are rounded to whole huge pages, so pass
+     * the same size to free_large().
+     * @return nullptr on failure
+     */
+    static void* allocate_large(size_t size, bool* huge_pages = nullptr) noexcept {
+        if (huge_pages != nullptr) {
+            *huge_pages = false;
+        }
+        
+        // Regions of a few pages gain nothing from huge pages
+        if (size >= HUGE_PAGE_SIZE) {
+            size = round_to_huge_page(size);
+            if (void* ptr = allocate_huge_pages(size)) {
+                if (huge_pages != nullptr) {
+                    *huge_pages = true;
+                }
+                return ptr;
+            }
+        }
+        
+        void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            return nullptr;
+        }
+        if (size >= HUGE_PAGE_SIZE) {
+            madvise(ptr, size, MADV_HUGEPAGE);
+        }
+        return ptr;
+    }
+    
+    /**
+     * Free memory from allocate_large
+     */
+    static void free_large(void* ptr, size_t size) noexcept {
+        if (ptr != nullptr) {
+            munmap(ptr, size >= HUGE_PAGE_SIZE ? round_to_huge_page(size) : size);
+        }
+    }
+    
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+    
+    static constexpr size_t round_to_huge_page(size_t size) noexcept {
+        return (size + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    }
+    
     /**
      * Warm up CPU (run busy loop to prevent frequency scaling)
      */
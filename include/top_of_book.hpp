@@ -0,0 +1,139 @@
+#pragma once
+
+#include "system_utils.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace fast_market {
+
+/**
+ * Consistent snapshot of one symbol's best bid and offer
+ * A price of 0 means that side is empty.
+ */
+struct TopOfBook {
+    uint32_t bid_price = 0;
+    uint32_t ask_price = 0;
+    uint64_t bid_shares = 0;
+    uint64_t ask_shares = 0;
+    uint64_t timestamp = 0;     // ITCH timestamp of the change
+    uint64_t version = 0;       // Changes published for this symbol so far
+};
+
+/**
+ * Top of book for every stock_locate, published through per-symbol seqlocks
+ * The book thread writes, any number of strategy threads read the latest
+ * quote without locks and without draining a queue of updates. Each entry
+ * is one cache line: a sequence word that is odd while a write is in
+ * progress, and the quote as relaxed atomic words. Readers retry if the
+ * sequence was odd or moved while they copied, so they never see a torn
+ * quote and never block the writer.
+ *
+ * One writer per entry: several BookManagers (e.g. ShardedPipeline
+ * workers) may share a table as long as their symbols are disjoint.
+ */
+class TopOfBookTable {
+public:
+    static constexpr size_t MAX_LOCATES = 65536;
+    
+    /**
+     * @throws std::bad_alloc if the table cannot be mapped
+     */
+    TopOfBookTable();
+    ~TopOfBookTable();
+    
+    TopOfBookTable(const TopOfBookTable&) = delete;
+    TopOfBookTable& operator=(const TopOfBookTable&) = delete;
+    
+    /**
+     * Publish a new quote (writer thread only)
+     * Calls that leave prices and sizes unchanged are dropped, so the
+     * timestamp is that of the last real change.
+     * @return true if the quote changed
+     */
+    bool publish(uint16_t stock_locate, uint32_t bid_price, uint64_t bid_shares,
+                 uint32_t ask_price, uint64_t ask_shares, uint64_t timestamp) noexcept {
+        Entry& entry = entries_[stock_locate];
+        const uint64_t prices = pack(bid_price, ask_price);
+        if (entry.prices.load(std::memory_order_relaxed) == prices &&
+            entry.bid_shares.load(std::memory_order_relaxed) == bid_shares &&
+            entry.ask_shares.load(std::memory_order_relaxed) == ask_shares) {
+            return false;
+        }
+        
+        const uint64_t sequence = entry.sequence.load(std::memory_order_relaxed);
+        entry.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        entry.prices.store(prices, std::memory_order_relaxed);
+        entry.bid_shares.store(bid_shares, std::memory_order_relaxed);
+        entry.ask_shares.store(ask_shares, std::memory_order_relaxed);
+        entry.timestamp.store(timestamp, std::memory_order_relaxed);
+        entry.sequence.store(sequence + 2, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * Single read attempt, wait-free
+     * @return false if a write was in progress; the caller may retry
+     */
+    [[nodiscard]] bool try_read(uint16_t stock_locate, TopOfBook& out) const noexcept {
+        const Entry& entry = entries_[stock_locate];
+        const uint64_t before = entry.sequence.load(std::memory_order_acquire);
+        if (before & 1) [[unlikely]] {
+            return false;
+        }
+        const uint64_t prices = entry.prices.load(std::memory_order_relaxed);
+        out.bid_shares = entry.bid_shares.load(std::memory_order_relaxed);
+        out.ask_shares = entry.ask_shares.load(std::memory_order_relaxed);
+        out.timestamp = entry.timestamp.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (entry.sequence.load(std::memory_order_relaxed) != before) [[unlikely]] {
+            return false;
+        }
+        out.bid_price = static_cast<uint32_t>(prices);
+        out.ask_price = static_cast<uint32_t>(prices >> 32);
+        out.version = before / 2;
+        return true;
+    }
+    
+    /**
+     * Latest quote, retrying until a consistent copy is read
+     */
+    [[nodiscard]] TopOfBook read(uint16_t stock_locate) const noexcept {
+        TopOfBook out;
+        while (!try_read(stock_locate, out)) [[unlikely]] {
+            SystemUtils::cpu_pause();
+        }
+        return out;
+    }
+    
+    /**
+     * Changes published for a symbol; cheap polling for "anything new?"
+     */
+    [[nodiscard]] uint64_t version(uint16_t stock_locate) const noexcept {
+        return entries_[stock_locate].sequence.load(std::memory_order_acquire) / 2;
+    }
+    
+    /**
+     * Reset every entry to an empty quote (no readers may be active)
+     */
+    void clear() noexcept;
+    
+private:
+    struct alignas(64) Entry {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<uint64_t> prices{0};      // Bid in the low half, ask in the high half
+        std::atomic<uint64_t> bid_shares{0};
+        std::atomic<uint64_t> ask_shares{0};
+        std::atomic<uint64_t> timestamp{0};
+    };
+    static_assert(sizeof(Entry) == 64, "One entry per cache line");
+    
+    static uint64_t pack(uint32_t bid_price, uint32_t ask_price) noexcept {
+        return static_cast<uint64_t>(ask_price) << 32 | bid_price;
+    }
+    
+    Entry* entries_ = nullptr;
+};
+
+} // namespace fast_market
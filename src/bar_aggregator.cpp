@@ -0,0 +1,10 @@
+// Implementation file for the bar aggregator
+// All functionality is template-based and inline in the header
+
+#include "bar_aggregator.hpp"
+
+namespace fast_market {
+
+// Template implementations are in the header
+
+} // namespace fast_market
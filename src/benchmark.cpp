@@ -1,4 +1,17 @@
 #include "itch_parser.hpp"
+#include "header_decoder.hpp"
+#include "parallel_file_parser.hpp"
+#include "gzip_stream.hpp"
+#include "sharded_pipeline.hpp"
+#include "order_book.hpp"
+#include "flat_order_map.hpp"
+#include "top_of_book.hpp"
+#include "book_checkpoint.hpp"
+#include "symbol_directory.hpp"
+#include "bar_aggregator.hpp"
+#include "columnar_log.hpp"
+#include "compact_log.hpp"
+#include "log_index.hpp"
 #include "async_logger.hpp"
 #include "system_utils.hpp"
 #include <iostream>
@@ -8,10 +21,21 @@
 #include <algorithm>
 #include <numeric>
 #include <memory>
+#include <cstdio>
 #include <cstring>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <unordered_map>
+#include <zlib.h>
 
 using namespace fast_market;
 
+// Wire encoding helpers for the synthetic messages
+uint16_t hton16(uint16_t x) { return __builtin_bswap16(x); }
+uint32_t hton32(uint32_t x) { return __builtin_bswap32(x); }
+uint64_t hton64(uint64_t x) { return __builtin_bswap64(x); }
+
 // Generate synthetic ITCH messages for testing
 class MessageGenerator {
 public:
@@ -22,7 +46,7 @@ public:
         add_order->header.message_type = static_cast<uint8_t>(MessageType::ADD_ORDER);
         add_order->header.stock_locate = hton16(1);
         add_order->header.tracking_number = hton16(counter_++);
-        add_order->header.timestamp = hton64(SystemUtils::rdtsc());
+        add_order->header.timestamp = hton48(SystemUtils::rdtsc());
         
         add_order->order_reference_number = hton64(1000000 + counter_);
         add_order->buy_sell_indicator = 'B';
@@ -40,7 +64,7 @@ public:
         exec->header.message_type = static_cast<uint8_t>(MessageType::EXECUTE_ORDER);
         exec->header.stock_locate = hton16(1);
         exec->header.tracking_number = hton16(counter_++);
-        exec->header.timestamp = hton64(SystemUtils::rdtsc());
+        exec->header.timestamp = hton48(SystemUtils::rdtsc());
         
         exec->order_reference_number = hton64(1000000 + counter_);
         exec->executed_shares = hton32(50);
@@ -50,10 +74,6 @@ public:
     }
     
 private:
-    uint16_t hton16(uint16_t x) { return __builtin_bswap16(x); }
-    uint32_t hton32(uint32_t x) { return __builtin_bswap32(x); }
-    uint64_t hton64(uint64_t x) { return __builtin_bswap64(x); }
-    
     uint32_t counter_ = 0;
 };
 
@@ -150,6 +170,774 @@ void benchmark_parser_only(size_t num_messages) {
     stats.print_summary(tsc_freq);
 }
 
+// Consumer that only reads a couple of fields, as a typical strategy does
+struct BenchmarkHandler {
+    uint64_t shares = 0;
+    
+    void on_add_order(const AddOrderView& msg) { shares += msg.shares(); }
+    void on_execute_order(const ExecuteOrderView& msg) { shares += msg.executed_shares(); }
+};
+
+void benchmark_handler_dispatch(size_t num_messages) {
+    std::cout << "\n=== Benchmark 1b: Handler Dispatch (No ParsedMessage) ===\n";
+    std::cout << "Messages to parse: " << num_messages << "\n";
+    
+    MessageGenerator gen;
+    ITCHParser parser;
+    BenchmarkHandler handler;
+    Stats stats;
+    
+    // Pre-generate messages
+    std::vector<std::vector<uint8_t>> messages;
+    messages.reserve(num_messages);
+    
+    for (size_t i = 0; i < num_messages; ++i) {
+        if (i % 2 == 0) {
+            messages.push_back(gen.generate_add_order());
+        } else {
+            messages.push_back(gen.generate_execute_order());
+        }
+    }
+    
+    std::cout << "Warming up CPU...\n";
+    SystemUtils::warmup_cpu(100);
+    
+    std::cout << "Parsing...\n";
+    uint64_t tsc_freq = SystemUtils::get_tsc_frequency();
+    stats.start_time = SystemUtils::rdtscp();
+    
+    for (const auto& msg : messages) {
+        uint64_t parse_start = SystemUtils::rdtscp();
+        bool parsed = parser.parse(msg.data(), msg.size(), handler);
+        uint64_t parse_end = SystemUtils::rdtscp();
+        
+        if (parsed) {
+            uint64_t latency = parse_end - parse_start;
+            stats.add_latency(latency);
+            stats.total_messages++;
+            stats.total_bytes += msg.size();
+        }
+    }
+    
+    stats.end_time = SystemUtils::rdtscp();
+    std::cout << "Checksum: " << handler.shares << "\n";
+    stats.print_summary(tsc_freq);
+}
+
+// One contiguous length-prefixed buffer, as read from a file
+std::vector<uint8_t> generate_framed_buffer(size_t num_messages) {
+    MessageGenerator gen;
+    std::vector<uint8_t> buffer;
+    for (size_t i = 0; i < num_messages; ++i) {
+        auto msg = (i % 2 == 0) ? gen.generate_add_order() : gen.generate_execute_order();
+        buffer.push_back(static_cast<uint8_t>(msg.size() >> 8));
+        buffer.push_back(static_cast<uint8_t>(msg.size()));
+        buffer.insert(buffer.end(), msg.begin(), msg.end());
+    }
+    return buffer;
+}
+
+void benchmark_batch_header_decode(size_t num_messages) {
+    std::cout << "\n=== Benchmark 1c: Batch Header Decode (SoA) ===\n";
+    std::cout << "Messages to decode: " << num_messages << "\n";
+    
+    std::vector<uint8_t> buffer = generate_framed_buffer(num_messages);
+    
+    std::vector<uint32_t> offsets(num_messages);
+    size_t consumed = 0;
+    size_t count = ITCHParser::index_frames(buffer.data(), buffer.size(), offsets.data(), offsets.size(), consumed);
+    
+    std::vector<uint8_t> types(count);
+    std::vector<uint16_t> locates(count), tracking(count);
+    std::vector<uint64_t> timestamps(count);
+    HeaderColumns columns{types.data(), locates.data(), tracking.data(), timestamps.data()};
+    
+    uint64_t tsc_freq = SystemUtils::get_tsc_frequency();
+    const SimdLevel levels[] = {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512};
+    const char* names[] = {"Scalar", "AVX2", "AVX-512"};
+    
+    for (size_t l = 0; l < 3; ++l) {
+        if (levels[l] > BatchHeaderDecoder::best_available()) {
+            std::cout << names[l] << ": not supported\n";
+            continue;
+        }
+        
+        // Best of several passes: the first faults in the columns, and wide
+        // vector units may need a moment to reach their power state
+        uint64_t best = UINT64_MAX;
+        for (int pass = 0; pass < 5; ++pass) {
+            uint64_t start = SystemUtils::rdtscp();
+            BatchHeaderDecoder::decode(levels[l], buffer.data(), buffer.size(), offsets.data(), count, columns);
+            best = std::min(best, SystemUtils::rdtscp() - start);
+        }
+        
+        double seconds = static_cast<double>(best) / tsc_freq;
+        std::cout << std::fixed << std::setprecision(2)
+                  << names[l] << ": " << (count / seconds / 1000000.0) << " M headers/sec ("
+                  << (static_cast<double>(best) / count) << " cycles/header)\n";
+    }
+}
+
+template<TimestampMode Mode>
+void run_timestamp_mode(const char* name, const std::vector<uint8_t>& buffer, uint64_t tsc_freq) {
+    BasicITCHParser<AllMessageTypes, Mode> parser;
+    uint64_t checksum = 0;
+    auto handler = [&](const ParsedMessage& msg) { checksum += msg.parse_timestamp_ns; };
+    
+    // Batches of about 64 KB, like a large recv() or file read
+    constexpr size_t CHUNK_SIZE = 64 * 1024;
+    uint64_t best = UINT64_MAX;
+    size_t parsed = 0;
+    for (int pass = 0; pass < 5; ++pass) {
+        parsed = 0;
+        parser.reset_stream();
+        uint64_t start = SystemUtils::rdtscp();
+        for (size_t offset = 0; offset < buffer.size(); offset += CHUNK_SIZE) {
+            const size_t n = std::min(CHUNK_SIZE, buffer.size() - offset);
+            parsed += parser.parse_stream(buffer.data() + offset, n, handler).messages_parsed;
+        }
+        best = std::min(best, SystemUtils::rdtscp() - start);
+    }
+    
+    double seconds = static_cast<double>(best) / tsc_freq;
+    std::cout << std::fixed << std::setprecision(2)
+              << name << ": " << (parsed / seconds / 1000000.0) << " M msgs/sec ("
+              << (static_cast<double>(best) / parsed) << " cycles/msg, checksum "
+              << (checksum & 0xFFFF) << ")\n";
+}
+
+void benchmark_timestamp_modes(size_t num_messages) {
+    std::cout << "\n=== Benchmark 1d: Stream Parse by Timestamp Mode ===\n";
+    std::cout << "Messages to parse: " << num_messages << "\n";
+    
+    std::vector<uint8_t> buffer = generate_framed_buffer(num_messages);
+    uint64_t tsc_freq = SystemUtils::get_tsc_frequency();
+    
+    run_timestamp_mode<TimestampMode::PER_MESSAGE>("Per message", buffer, tsc_freq);
+    run_timestamp_mode<TimestampMode::PER_BATCH>("Per batch  ", buffer, tsc_freq);
+    run_timestamp_mode<TimestampMode::NONE>("None       ", buffer, tsc_freq);
+}
+
+void benchmark_parallel_file_parse(size_t num_messages) {
+    std::cout << "\n=== Benchmark 1e: Parallel Chunked Parse ===\n";
+    std::cout << "Messages to parse: " << num_messages << "\n";
+    
+    std::vector<uint8_t> buffer = generate_framed_buffer(num_messages);
+    uint64_t tsc_freq = SystemUtils::get_tsc_frequency();
+    
+    struct Checksum {
+        uint64_t sum = 0;
+        void operator()(const ParsedMessage& msg) { sum += static_cast<uint8_t>(msg.type); }
+    };
+    
+    const size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        ParallelFileParser parser(buffer.data(), buffer.size(), threads);
+        uint64_t best = UINT64_MAX;
+        size_t parsed = 0;
+        for (int pass = 0; pass < 3; ++pass) {
+            uint64_t start = SystemUtils::rdtscp();
+            auto result = parser.parse<BasicITCHParser<AllMessageTypes, TimestampMode::NONE>>(
+                [](size_t) { return Checksum{}; });
+            best = std::min(best, SystemUtils::rdtscp() - start);
+            parsed = result.total.messages_parsed;
+        }
+        
+        double seconds = static_cast<double>(best) / tsc_freq;
+        std::cout << std::fixed << std::setprecision(2)
+                  << threads << " thread(s): " << (parsed / seconds / 1000000.0) << " M msgs/sec\n";
+    }
+}
+
+void benchmark_gzip_stream(size_t num_messages) {
+    std::cout << "\n=== Benchmark 1f: Pipelined Gzip Input ===\n";
+    std::cout << "Messages to parse: " << num_messages << "\n";
+    
+    std::vector<uint8_t> buffer = generate_framed_buffer(num_messages);
+    const char* path = "benchmark_input.gz";
+    gzFile out = gzopen(path, "wb6");
+    gzwrite(out, buffer.data(), static_cast<unsigned>(buffer.size()));
+    gzclose(out);
+    
+    struct Checksum {
+        uint64_t sum = 0;
+        void operator()(const ParsedMessage& msg) { sum += static_cast<uint8_t>(msg.type); }
+    };
+    
+    auto parser = std::make_unique<BasicITCHParser<AllMessageTypes, TimestampMode::NONE>>();
+    Checksum checksum;
+    const auto start = std::chrono::steady_clock::now();
+    GzipStreamReader reader(path);
+    BatchResult result = reader.parse(*parser, checksum);
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const GzipStreamStats& stats = reader.stats();
+    
+    std::cout << std::fixed << std::setprecision(2)
+              << "Compressed:      " << stats.compressed_bytes / 1e6 << " MB -> "
+              << stats.decompressed_bytes / 1e6 << " MB\n"
+              << "Decompress:      " << stats.decompress_mb_per_sec() << " MB/sec\n"
+              << "Parse:           " << stats.parse_mb_per_sec() << " MB/sec\n"
+              << "Parser stalled:  " << stats.consumer_wait_seconds * 1000.0 << " ms\n"
+              << "Inflate stalled: " << stats.producer_wait_seconds * 1000.0 << " ms\n"
+              << "End to end:      " << (result.messages_parsed / wall / 1000000.0) << " M msgs/sec\n";
+    std::remove(path);
+}
+
+void benchmark_sharded_pipeline(size_t num_messages) {
+    std::cout << "\n=== Benchmark 1g: Symbol-Sharded Pipeline ===\n";
+    std::cout << "Messages to route: " << num_messages << "\n";
+    
+    std::vector<uint8_t> buffer = generate_framed_buffer(num_messages);
+    uint64_t tsc_freq = SystemUtils::get_tsc_frequency();
+    
+    struct Checksum {
+        uint64_t sum = 0;
+        void operator()(const ParsedMessage& msg) { sum += static_cast<uint8_t>(msg.type); }
+    };
+    
+    // Router on core 0, workers on the cores after it
+    const int cpus = SystemUtils::get_cpu_count();
+    for (size_t workers = 1; workers <= static_cast<size_t>(std::max(1, cpus - 1)); workers *= 2) {
+        std::vector<int> cores;
+        for (size_t i = 0; i < workers && cpus > 1; ++i) {
+            cores.push_back(static_cast<int>(1 + i % (cpus - 1)));
+        }
+        
+        ShardedPipeline<Checksum, BasicITCHParser<AllMessageTypes, TimestampMode::NONE>> pipeline(
+            workers, [](size_t) { return Checksum{}; }, cores);
+        uint64_t start = SystemUtils::rdtscp();
+        BatchResult routed = pipeline.route_batch(buffer.data(), buffer.size());
+        pipeline.finish();
+        double seconds = static_cast<double>(SystemUtils::rdtscp() - start) / tsc_freq;
+        
+        std::cout << std::fixed << std::setprecision(2)
+                  << workers << " worker(s): " << (routed.messages_parsed / seconds / 1000000.0)
+                  << " M msgs/sec, router stalls: " << pipeline.stats().stalls << "\n";
+    }
+}
+
+// Order flow for book benchmarks: adds around a drifting mid, then executes,
+// cancels, deletes and replaces against live orders (ntoh* swaps both ways)
+std::vector<uint8_t> generate_book_workload(size_t num_messages, uint16_t symbols = 64) {
+    std::mt19937_64 rng(42);
+    std::vector<uint8_t> buffer;
+    struct LiveOrder {
+        uint64_t ref;
+        uint16_t locate;
+        uint32_t shares;
+    };
+    std::vector<LiveOrder> live;
+    std::vector<uint32_t> mid(symbols + 1, 1000000);
+    uint64_t next_ref = 1;
+    
+    auto append = [&buffer](const void* msg, size_t size) {
+        buffer.push_back(static_cast<uint8_t>(size >> 8));
+        buffer.push_back(static_cast<uint8_t>(size));
+        const auto* bytes = static_cast<const uint8_t*>(msg);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    };
+    
+    for (size_t i = 0; i < num_messages; ++i) {
+        unsigned action = static_cast<unsigned>(rng() % 100);
+        if (live.size() < 1000 || action < 45) {
+            const uint16_t locate = static_cast<uint16_t>(1 + rng() % symbols);
+            const bool buy = rng() & 1;
+            mid[locate] += static_cast<uint32_t>(rng() % 3) * 100 - 100;
+            AddOrderMessage msg{};
+            msg.header.message_type = static_cast<uint8_t>(MessageType::ADD_ORDER);
+            msg.header.stock_locate = hton16(locate);
+            msg.order_reference_number = hton64(next_ref);
+            msg.buy_sell_indicator = buy ? 'B' : 'S';
+            const uint32_t shares = 100 * static_cast<uint32_t>(1 + rng() % 10);
+            msg.shares = hton32(shares);
+            const uint32_t offset = 100 * static_cast<uint32_t>(1 + rng() % 20);
+            msg.price = hton32(buy ? mid[locate] - offset : mid[locate] + offset);
+            append(&msg, sizeof(msg));
+            live.push_back({next_ref++, locate, shares});
+            continue;
+        }
+        
+        // Pick a live order; executes and cancels take one round lot
+        const size_t pick = rng() % live.size();
+        const auto [ref, locate, shares] = live[pick];
+        if (action < 70 && shares > 100) {
+            live[pick].shares -= 100;
+        } else if (action < 95) {
+            action = 70;  // Last lot: delete instead
+        }
+        if (action < 55) {
+            ExecuteOrderMessage msg{};
+            msg.header.message_type = static_cast<uint8_t>(MessageType::EXECUTE_ORDER);
+            msg.header.stock_locate = hton16(locate);
+            msg.order_reference_number = hton64(ref);
+            msg.executed_shares = hton32(100);
+            append(&msg, sizeof(msg));
+        } else if (action < 70) {
+            OrderCancelMessage msg{};
+            msg.header.message_type = static_cast<uint8_t>(MessageType::ORDER_CANCEL);
+            msg.header.stock_locate = hton16(locate);
+            msg.order_reference_number = hton64(ref);
+            msg.cancelled_shares = hton32(100);
+            append(&msg, sizeof(msg));
+        } else if (action < 95) {
+            OrderDeleteMessage msg{};
+            msg.header.message_type = static_cast<uint8_t>(MessageType::ORDER_DELETE);
+            msg.header.stock_locate = hton16(locate);
+            msg.order_reference_number = hton64(ref);
+            append(&msg, sizeof(msg));
+            live[pick] = live.back();
+            live.pop_back();
+        } else {
+            OrderReplaceMessage msg{};
+            msg.header.message_type = static_cast<uint8_t>(MessageType::ORDER_REPLACE);
+            msg.header.stock_locate = hton16(locate);
+            msg.original_order_reference_number = hton64(ref);
+            msg.new_order_reference_number = hton64(next_ref);
+            const uint32_t new_shares = 100 * static_cast<uint32_t>(1 + rng() % 10);
+            msg.shares = hton32(new_shares);
+            msg.price = hton32(mid[locate] - 100 * static_cast<uint32_t>(1 + rng() % 20));
+            append(&msg, sizeof(msg));
+            live[pick] = {next_ref++, locate, new_shares};
+        }
+    }
+    return buffer;
+}
+
+void benchmark_order_book(size_t num_messages) {
+    std::cout << "\n=== Benchmark 1h: L3 Order Book Updates ===\n";
+    std::cout << "Messages to apply: " << num_messages << "\n";
+    
+    std::vector<uint8_t> buffer = generate_book_workload(num_messages);
+    uint64_t tsc_freq = SystemUtils::get_tsc_frequency();
+    
+    auto parser = std::make_unique<BasicITCHParser<AllMessageTypes, TimestampMode::NONE>>();
+    BookManager books(num_messages);
+    uint64_t start = SystemUtils::rdtscp();
+    BatchResult result = parser->parse_batch(buffer.data(), buffer.size(), books);
+    uint64_t cycles = SystemUtils::rdtscp() - start;
+    
+    double ns_per_msg = static_cast<double>(cycles) / tsc_freq * 1e9 / result.messages_parsed;
+    std::cout << std::fixed << std::setprecision(2)
+              << "Parse + book update: " << ns_per_msg << " ns/msg\n"
+              << "Live orders: " << books.order_count()
+              << ", unknown references: " << books.stats().unknown_orders << "\n"
+              << "Order pool high water: " << books.order_pool_stats().high_water
+              << ", level pool high water: " << books.level_pool_stats().high_water
+              << (books.order_pool_stats().huge_pages ? " (huge pages)" : "") << "\n";
+    
+    // Warm restart from a checkpoint of the final state
+    const char* checkpoint = "benchmark_checkpoint.bin";
+    auto save_start = std::chrono::steady_clock::now();
+    BookCheckpoint::save(books, checkpoint, result.messages_parsed + 1);
+    auto load_start = std::chrono::steady_clock::now();
+    BookManager restored(num_messages);
+    const CheckpointInfo info = BookCheckpoint::load(restored, checkpoint);
+    auto load_end = std::chrono::steady_clock::now();
+    std::remove(checkpoint);
+    std::cout << "Checkpoint of " << info.orders << " orders: save "
+              << std::chrono::duration<double, std::milli>(load_start - save_start).count() << " ms, restore "
+              << std::chrono::duration<double, std::milli>(load_end - load_start).count() << " ms\n";
+}
+
+// One add, one lookup and one delete per step against a steady live set
+template<typename Map, typename Insert, typename Find, typename Erase>
+double run_order_map(Map& map, size_t live, size_t steps, Insert insert, Find find, Erase erase,
+                     uint64_t tsc_freq, uint64_t& total_checksum) {
+    std::mt19937_64 rng(11);
+    for (uint64_t key = 1; key <= live; ++key) {
+        insert(map, key);
+    }
+    
+    uint64_t next_key = live + 1;
+    uint64_t checksum = 0;
+    uint64_t start = SystemUtils::rdtscp();
+    for (size_t i = 0; i < steps; ++i) {
+        // Live keys are the window [next_key - live, next_key), probed at random
+        insert(map, next_key);
+        checksum += find(map, next_key - live + rng() % live);
+        erase(map, next_key - live);
+        ++next_key;
+    }
+    uint64_t cycles = SystemUtils::rdtscp() - start;
+    total_checksum += checksum;
+    return static_cast<double>(cycles) / tsc_freq * 1e9 / (3.0 * steps);
+}
+
+void benchmark_order_map(size_t num_messages) {
+    std::cout << "\n=== Benchmark 1i: Order Reference Lookup ===\n";
+    uint64_t tsc_freq = SystemUtils::get_tsc_frequency();
+    
+    uint64_t checksum = 0;
+    for (size_t live : {size_t{100000}, size_t{4000000}}) {
+        std::unordered_map<uint64_t, uint64_t> std_map;
+        std_map.reserve(live);
+        double std_ns = run_order_map(std_map, live, num_messages,
+            [](auto& m, uint64_t k) { m.emplace(k, k); },
+            [](auto& m, uint64_t k) { auto it = m.find(k); return it != m.end() ? it->second : 0; },
+            [](auto& m, uint64_t k) { m.erase(k); }, tsc_freq, checksum);
+        
+        FlatOrderMap<uint64_t> flat_map(live);
+        double flat_ns = run_order_map(flat_map, live, num_messages,
+            [](auto& m, uint64_t k) { m.insert(k, k); },
+            [](auto& m, uint64_t k) { const uint64_t* v = m.find(k); return v ? *v : 0; },
+            [](auto& m, uint64_t k) { m.erase(k); }, tsc_freq, checksum);
+        
+        std::cout << std::fixed << std::setprecision(2)
+                  << live << " live orders: std::unordered_map " << std_ns << " ns/op, FlatOrderMap "
+                  << flat_ns << " ns/op" << (flat_map.huge_pages() ? " (huge pages)" : "") << "\n";
+    }
+    std::cout << "Checksum: " << checksum << "\n";
+}
+
+void benchmark_top_of_book(size_t num_messages) {
+    std::cout << "\n=== Benchmark 1j: Seqlock Top-of-Book ===\n";
+    
+    std::vector<uint8_t> buffer = generate_book_workload(num_messages);
+    uint64_t tsc_freq = SystemUtils::get_tsc_frequency();
+    
+    // Book thread publishing while a strategy thread polls quotes (when
+    // there is a second core, otherwise the two would share a time slice)
+    auto table = std::make_unique<TopOfBookTable>();
+    auto parser = std::make_unique<BasicITCHParser<AllMessageTypes, TimestampMode::NONE>>();
+    BookManager books(num_messages);
+    books.set_top_of_book(table.get());
+    
+    std::atomic<bool> done{false};
+    uint64_t concurrent_reads = 0;
+    uint64_t concurrent_checksum = 0;
+    std::thread reader([&] {
+        if (SystemUtils::get_cpu_count() < 2) {
+            return;
+        }
+        uint64_t checksum = 0;
+        for (uint16_t locate = 1; !done.load(std::memory_order_relaxed); locate = locate % 64 + 1) {
+            checksum += table->read(locate).bid_price;
+            ++concurrent_reads;
+        }
+        concurrent_checksum = checksum;
+    });
+    
+    uint64_t start = SystemUtils::rdtscp();
+    BatchResult result = parser->parse_batch(buffer.data(), buffer.size(), books);
+    uint64_t cycles = SystemUtils::rdtscp() - start;
+    done.store(true, std::memory_order_relaxed);
+    reader.join();
+    double write_ns = static_cast<double>(cycles) / tsc_freq * 1e9 / result.messages_parsed;
+    
+    // Uncontended read latency
+    const size_t reads = num_messages;
+    uint64_t checksum = 0;
+    start = SystemUtils::rdtscp();
+    for (size_t i = 0; i < reads; ++i) {
+        const TopOfBook top = table->read(static_cast<uint16_t>(1 + i % 64));
+        checksum += top.bid_price + top.ask_shares;
+    }
+    cycles = SystemUtils::rdtscp() - start;
+    double read_ns = static_cast<double>(cycles) / tsc_freq * 1e9 / reads;
+    
+    std::cout << std::fixed << std::setprecision(2)
+              << "Parse + book update + publish: " << write_ns << " ns/msg\n"
+              << "Quote read: " << read_ns << " ns/read (" << concurrent_reads
+              << " reads during updates)\n"
+              << "Checksum: " << checksum + concurrent_checksum << "\n";
+}
+
+void benchmark_symbol_directory(size_t num_messages) {
+    std::cout << "\n=== Benchmark 1k: Symbol Resolution ===\n";
+    uint64_t tsc_freq = SystemUtils::get_tsc_frequency();
+    
+    // A listing of short padded symbols, as in the morning directory
+    constexpr size_t SYMBOLS = 10000;
+    auto directory = std::make_unique<SymbolDirectory>();
+    std::vector<std::array<char, 8>> stocks(SYMBOLS);
+    std::unordered_map<std::string, uint16_t> by_name;
+    std::mt19937 rng(5);
+    for (size_t i = 0; i < SYMBOLS; ++i) {
+        SymbolInfo info;
+        info.stock.fill(' ');
+        const size_t length = 2 + i % 4;
+        for (size_t c = 0; c < length; ++c) {
+            info.stock[c] = static_cast<char>('A' + rng() % 26);
+        }
+        info.stock[length] = static_cast<char>('A' + i % 26);
+        info.stock[length + 1] = static_cast<char>('A' + i / 26 % 26);
+        info.stock[length + 2] = static_cast<char>('0' + i / 676 % 10);
+        stocks[i] = info.stock;
+        directory->add(static_cast<uint16_t>(i + 1), info);
+        by_name.emplace(std::string(get_stock_symbol(info.stock)), static_cast<uint16_t>(i + 1));
+    }
+    
+    uint64_t checksum = 0;
+    auto time_ns = [&](auto&& fn) {
+        uint64_t sum = 0;
+        uint64_t start = SystemUtils::rdtscp();
+        for (size_t i = 0; i < num_messages; ++i) {
+            sum += fn(i % SYMBOLS);
+        }
+        uint64_t cycles = SystemUtils::rdtscp() - start;
+        checksum += sum;
+        return static_cast<double>(cycles) / tsc_freq * 1e9 / num_messages;
+    };
+    
+    double trim_ns = time_ns([&](size_t i) { return get_stock_symbol(stocks[i]).size(); });
+    double load_ns = time_ns([&](size_t i) { return directory->symbol(static_cast<uint16_t>(i + 1)).size(); });
+    double string_ns = time_ns([&](size_t i) { return by_name.find(std::string(get_stock_symbol(stocks[i])))->second; });
+    double key_ns = time_ns([&](size_t i) { return directory->locate(stocks[i]); });
+    
+    std::cout << std::fixed << std::setprecision(2)
+              << "Locate -> symbol: trim " << trim_ns << " ns, directory " << load_ns << " ns\n"
+              << "Symbol -> locate: std::unordered_map<std::string> " << string_ns << " ns, directory "
+              << key_ns << " ns\n"
+              << "Checksum: " << checksum << "\n";
+}
+
+void benchmark_bar_aggregator(size_t num_messages) {
+    std::cout << "\n=== Benchmark 1l: OHLCV Bar Aggregation ===\n";
+    uint64_t tsc_freq = SystemUtils::get_tsc_frequency();
+    
+    // Trades spread over a 6.5 hour session across 8000 symbols
+    constexpr size_t SYMBOLS = 8000;
+    const uint64_t open_ns = 34200ULL * 1000000000ULL;
+    const uint64_t step_ns = 23400ULL * 1000000000ULL / num_messages;
+    std::vector<uint32_t> last(SYMBOLS + 1, 1000000);
+    std::vector<uint8_t> buffer;
+    buffer.reserve(num_messages * (sizeof(TradeMessage) + 2));
+    std::mt19937 rng(3);
+    for (size_t i = 0; i < num_messages; ++i) {
+        const uint16_t locate = static_cast<uint16_t>(1 + rng() % SYMBOLS);
+        last[locate] += static_cast<uint32_t>(rng() % 3) * 100 - 100;
+        TradeMessage msg{};
+        msg.header.message_type = static_cast<uint8_t>(MessageType::TRADE);
+        msg.header.stock_locate = hton16(locate);
+        msg.header.timestamp = hton48(open_ns + i * step_ns);
+        msg.shares = hton32(100);
+        msg.price = hton32(last[locate]);
+        buffer.push_back(static_cast<uint8_t>(sizeof(msg) >> 8));
+        buffer.push_back(static_cast<uint8_t>(sizeof(msg)));
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&msg);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(msg));
+    }
+    
+    for (uint64_t interval : {1000000000ULL, 60000000000ULL}) {
+        uint64_t volume = 0;
+        auto sink = [&volume](const Bar* bars, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                volume += bars[i].volume;
+            }
+        };
+        auto aggregator = std::make_unique<BarAggregator<decltype(sink)>>(interval, sink);
+        auto parser = std::make_unique<BasicITCHParser<AllMessageTypes, TimestampMode::NONE>>();
+        
+        uint64_t start = SystemUtils::rdtscp();
+        BatchResult result = parser->parse_batch(buffer.data(), buffer.size(), *aggregator);
+        aggregator->flush();
+        uint64_t cycles = SystemUtils::rdtscp() - start;
+        
+        double ns_per_msg = static_cast<double>(cycles) / tsc_freq * 1e9 / result.messages_parsed;
+        std::cout << std::fixed << std::setprecision(2)
+                  << (interval / 1000000000ULL) << " s bars: " << ns_per_msg << " ns/trade, "
+                  << aggregator->stats().bars << " bars in " << aggregator->stats().batches << " batches"
+                  << (volume == aggregator->stats().trades * 100 ? "" : " (volume mismatch)") << "\n";
+    }
+}
+
+void benchmark_columnar_log(size_t num_messages) {
+    std::cout << "\n=== Benchmark 1m: Columnar Log vs Row Log ===\n";
+    uint64_t tsc_freq = SystemUtils::get_tsc_frequency();
+    
+    std::vector<uint8_t> buffer = generate_framed_buffer(num_messages);
+    std::vector<ParsedMessage> messages;
+    messages.reserve(num_messages);
+    ITCHParser parser;
+    parser.parse_stream(buffer.data(), buffer.size(), [&messages](const ParsedMessage& msg) {
+        messages.push_back(msg);
+    });
+    
+    // Row log as AsyncLogger writes it: packed structs back to back
+    std::vector<uint8_t> rows;
+    for (const ParsedMessage& msg : messages) {
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&msg.system_event);
+        rows.insert(rows.end(), bytes, bytes + MESSAGE_LENGTHS[static_cast<uint8_t>(msg.type)]);
+    }
+    
+    const char* path = "benchmark_columnar.bin";
+    const int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cout << "Could not create " << path << "\n";
+        return;
+    }
+    uint64_t start = SystemUtils::rdtscp();
+    uint64_t columnar_bytes = 0;
+    {
+        ColumnarWriter writer(fd);
+        for (const ParsedMessage& msg : messages) {
+            writer.append(msg);
+        }
+        writer.finish();
+        columnar_bytes = writer.bytes_written();
+    }
+    uint64_t cycles = SystemUtils::rdtscp() - start;
+    ::close(fd);
+    std::cout << std::fixed << std::setprecision(2)
+              << "Columnar write: " << (static_cast<double>(cycles) / tsc_freq * 1e9 / messages.size())
+              << " ns/msg, " << columnar_bytes << " bytes (row log " << rows.size() << " bytes)\n";
+    
+    // Scan: shares and notional of every add order
+    uint64_t row_shares = 0, row_notional = 0;
+    start = SystemUtils::rdtscp();
+    for (size_t offset = 0; offset < rows.size(); offset += MESSAGE_LENGTHS[rows[offset]]) {
+        if (rows[offset] == static_cast<uint8_t>(MessageType::ADD_ORDER)) {
+            AddOrderMessage add;
+            std::memcpy(&add, rows.data() + offset, sizeof(add));
+            row_shares += add.shares;
+            row_notional += static_cast<uint64_t>(add.price) * add.shares;
+        }
+    }
+    const uint64_t row_cycles = SystemUtils::rdtscp() - start;
+    
+    ColumnarLogReader reader(path);
+    const int price = ColumnarLogReader::column_index(MessageType::ADD_ORDER, "price");
+    const int shares = ColumnarLogReader::column_index(MessageType::ADD_ORDER, "shares");
+    uint64_t col_shares = 0, col_notional = 0, scanned = 0;
+    start = SystemUtils::rdtscp();
+    for (size_t group = 0; group < reader.row_group_count(); ++group) {
+        const RowGroupMeta& meta = reader.row_group(group);
+        if (meta.message_type != static_cast<uint8_t>(MessageType::ADD_ORDER)) {
+            continue;
+        }
+        const uint32_t* prices = reader.column_as<uint32_t>(group, price);
+        const uint32_t* sizes = reader.column_as<uint32_t>(group, shares);
+        for (uint32_t i = 0; i < meta.rows; ++i) {
+            col_shares += sizes[i];
+            col_notional += static_cast<uint64_t>(prices[i]) * sizes[i];
+        }
+        scanned += reader.column_bytes(group, price) + reader.column_bytes(group, shares);
+    }
+    const uint64_t col_cycles = SystemUtils::rdtscp() - start;
+    
+    std::cout << "Row scan:      " << (static_cast<double>(row_cycles) / tsc_freq * 1e3) << " ms, "
+              << rows.size() << " bytes read\n";
+    std::cout << "Columnar scan: " << (static_cast<double>(col_cycles) / tsc_freq * 1e3) << " ms, "
+              << scanned << " bytes read (" << (static_cast<double>(rows.size()) / scanned) << "x less)"
+              << (row_shares == col_shares && row_notional == col_notional ? "" : " (sum mismatch)") << "\n";
+    std::remove(path);
+}
+
+void benchmark_compact_log(size_t num_messages) {
+    std::cout << "\n=== Benchmark 1n: Compact Log Encoding ===\n";
+    uint64_t tsc_freq = SystemUtils::get_tsc_frequency();
+    
+    std::vector<uint8_t> buffer = generate_framed_buffer(num_messages);
+    std::vector<ParsedMessage> messages;
+    messages.reserve(num_messages);
+    ITCHParser parser;
+    parser.parse_stream(buffer.data(), buffer.size(), [&messages](const ParsedMessage& msg) {
+        messages.push_back(msg);
+    });
+    
+    size_t row_bytes = 0;
+    for (const ParsedMessage& msg : messages) {
+        row_bytes += MESSAGE_LENGTHS[static_cast<uint8_t>(msg.type)];
+    }
+    
+    std::vector<uint8_t> encoded(messages.size() * CompactEncoder::MAX_RECORD_SIZE);
+    CompactEncoder encoder;
+    size_t size = 0;
+    uint64_t start = SystemUtils::rdtscp();
+    for (const ParsedMessage& msg : messages) {
+        size += encoder.encode(msg, encoded.data() + size);
+    }
+    const uint64_t encode_cycles = SystemUtils::rdtscp() - start;
+    
+    CompactDecoder decoder;
+    ParsedMessage decoded;
+    uint64_t checksum = 0;
+    size_t records = 0;
+    start = SystemUtils::rdtscp();
+    for (size_t offset = 0; offset < size; ++records) {
+        const size_t used = decoder.decode(encoded.data() + offset, size - offset, decoded);
+        if (used == 0) {
+            break;
+        }
+        offset += used;
+        checksum += decoded.system_event.header.tracking_number;
+    }
+    const uint64_t decode_cycles = SystemUtils::rdtscp() - start;
+    
+    std::cout << std::fixed << std::setprecision(2)
+              << "Row log: " << row_bytes << " bytes, compact: " << size << " bytes ("
+              << (static_cast<double>(row_bytes) / size) << "x smaller)\n"
+              << "Encode: " << (static_cast<double>(encode_cycles) / tsc_freq * 1e9 / messages.size()) << " ns/msg, "
+              << "decode: " << (static_cast<double>(decode_cycles) / tsc_freq * 1e9 / messages.size()) << " ns/msg"
+              << (records == messages.size() ? "" : " (decode mismatch)") << "\n"
+              << "Checksum: " << checksum << "\n";
+}
+
+void benchmark_log_index(size_t num_messages) {
+    std::cout << "\n=== Benchmark 1o: Indexed Log Seek ===\n";
+    uint64_t tsc_freq = SystemUtils::get_tsc_frequency();
+    
+    // A 6.5 hour session logged with an index point per 4096 records or 1 s
+    const uint64_t open_ns = 34200ULL * 1000000000ULL;
+    const uint64_t step_ns = 23400ULL * 1000000000ULL / num_messages;
+    std::vector<uint8_t> buffer = generate_framed_buffer(num_messages);
+    ITCHParser parser;
+    const char* path = "benchmark_indexed.bin";
+    {
+        auto logger = std::make_unique<AsyncLogger>(path, AsyncLogger::WriteMode::BUFFERED);
+        logger->enable_index(4096, 1000000000);
+        logger->start();
+        uint64_t i = 0;
+        parser.parse_stream(buffer.data(), buffer.size(), [&](const ParsedMessage& msg) {
+            ParsedMessage stamped = msg;
+            const uint64_t timestamp = open_ns + i++ * step_ns;
+            stamped.system_event.header.timestamp.high = static_cast<uint16_t>(timestamp >> 32);
+            stamped.system_event.header.timestamp.low = static_cast<uint32_t>(timestamp);
+            while (!logger->log(stamped)) {
+                std::this_thread::yield();
+            }
+        });
+        logger->stop();
+    }
+    
+    IndexedLogReader reader(path);
+    std::mt19937_64 rng(5);
+    constexpr int QUERIES = 1000;
+    uint64_t checksum = 0;
+    uint64_t start = SystemUtils::rdtscp();
+    for (int q = 0; q < QUERIES; ++q) {
+        const uint64_t target = open_ns + rng() % (num_messages * step_ns);
+        reader.scan_from_time(target, [&checksum](const ParsedMessage&, uint64_t ordinal) {
+            checksum += ordinal;
+            return false;
+        });
+    }
+    const uint64_t indexed_cycles = SystemUtils::rdtscp() - start;
+    
+    // Without the index a query reads from the start of the log
+    constexpr int LINEAR_QUERIES = 5;
+    start = SystemUtils::rdtscp();
+    for (int q = 0; q < LINEAR_QUERIES; ++q) {
+        const uint64_t target = open_ns + rng() % (num_messages * step_ns);
+        reader.scan_from_ordinal(0, [&](const ParsedMessage& msg, uint64_t ordinal) {
+            if (msg.system_event.header.timestamp.value() < target) {
+                return true;
+            }
+            checksum += ordinal;
+            return false;
+        });
+    }
+    const uint64_t linear_cycles = SystemUtils::rdtscp() - start;
+    
+    std::cout << std::fixed << std::setprecision(2)
+              << reader.entries().size() << " index points for " << num_messages << " records\n"
+              << "Indexed seek: " << (static_cast<double>(indexed_cycles) / tsc_freq * 1e6 / QUERIES) << " us/query\n"
+              << "Linear scan:  " << (static_cast<double>(linear_cycles) / tsc_freq * 1e6 / LINEAR_QUERIES) << " us/query\n"
+              << "Checksum: " << checksum << "\n";
+    std::remove(path);
+    std::remove((std::string(path) + ".idx").c_str());
+}
+
 void benchmark_parser_with_logger(size_t num_messages) {
     std::cout << "\n=== Benchmark 2: Parser + Async Logger ===\n";
     std::cout << "Messages to parse: " << num_messages << "\n";
@@ -276,6 +1064,20 @@ int main(int argc, char* argv[]) {
     
     // Run benchmarks
     benchmark_parser_only(num_messages);
+    benchmark_handler_dispatch(num_messages);
+    benchmark_batch_header_decode(num_messages);
+    benchmark_timestamp_modes(num_messages);
+    benchmark_parallel_file_parse(num_messages);
+    benchmark_gzip_stream(num_messages);
+    benchmark_sharded_pipeline(num_messages);
+    benchmark_order_book(num_messages);
+    benchmark_order_map(num_messages);
+    benchmark_top_of_book(num_messages);
+    benchmark_symbol_directory(num_messages);
+    benchmark_bar_aggregator(num_messages);
+    benchmark_columnar_log(num_messages);
+    benchmark_compact_log(num_messages);
+    benchmark_log_index(num_messages);
     benchmark_parser_with_logger(num_messages);
     benchmark_with_cpu_pinning(num_messages);
     
@@ -0,0 +1,180 @@
+// Implementation file for book checkpoints
+// File layout and mapping; only run at checkpoint and restart time
+
+#include "book_checkpoint.hpp"
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fast_market {
+
+namespace {
+
+static_assert(std::is_trivially_copyable_v<CheckpointHeader>, "Header is copied as raw bytes");
+static_assert(std::is_trivially_copyable_v<SymbolInfo>, "Directory entries are copied as raw bytes");
+
+// Sections start 64-byte aligned after the header
+constexpr uint64_t align_section(uint64_t offset) noexcept {
+    return (offset + 63) & ~uint64_t{63};
+}
+
+bool section_fits(uint64_t offset, uint64_t count, size_t record_size, uint64_t file_size) noexcept {
+    return offset <= file_size && count <= (file_size - offset) / record_size;
+}
+
+} // namespace
+
+CheckpointInfo BookCheckpoint::save(const BookManager& books, const std::string& path, uint64_t sequence) {
+    CheckpointHeader header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.header_size = sizeof(CheckpointHeader);
+    header.sequence = sequence;
+    header.stats = books.stats_;
+    
+    header.symbol_count = books.symbols_.size();
+    for (const auto& book : books.books_) {
+        header.book_count += (book != nullptr);
+    }
+    header.order_count = books.orders_.size();
+    
+    header.symbols_offset = align_section(sizeof(CheckpointHeader));
+    header.books_offset = align_section(header.symbols_offset + header.symbol_count * sizeof(CheckpointSymbol));
+    header.orders_offset = align_section(header.books_offset + header.book_count * sizeof(CheckpointBook));
+    header.file_size = header.orders_offset + header.order_count * sizeof(CheckpointOrder);
+    
+    const std::string temp_path = path + ".tmp";
+    const int fd = open(temp_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to create checkpoint: " + temp_path);
+    }
+    if (ftruncate(fd, static_cast<off_t>(header.file_size)) != 0) {
+        close(fd);
+        unlink(temp_path.c_str());
+        throw std::runtime_error("Failed to size checkpoint: " + temp_path);
+    }
+    void* mapped = mmap(nullptr, header.file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        unlink(temp_path.c_str());
+        throw std::runtime_error("Failed to mmap checkpoint: " + temp_path);
+    }
+    auto* base = static_cast<uint8_t*>(mapped);
+    
+    auto* symbol = reinterpret_cast<CheckpointSymbol*>(base + header.symbols_offset);
+    books.symbols_.for_each([&symbol](uint16_t locate, const SymbolInfo& info) {
+        *symbol++ = CheckpointSymbol{locate, {}, info};
+    });
+    
+    auto* record = reinterpret_cast<CheckpointBook*>(base + header.books_offset);
+    auto* order = reinterpret_cast<CheckpointOrder*>(base + header.orders_offset);
+    for (const auto& book : books.books_) {
+        if (book == nullptr) {
+            continue;
+        }
+        const CheckpointOrder* first = order;
+        auto write_level = [&order](const PriceLevel& level) {
+            for (const BookOrder* resting = level.head; resting != nullptr; resting = resting->next) {
+                *order++ = CheckpointOrder{resting->reference, resting->price, resting->shares,
+                                           resting->stock_locate, static_cast<uint8_t>(resting->side), {}};
+            }
+            return true;
+        };
+        book->for_each_level(Side::BUY, write_level);
+        book->for_each_level(Side::SELL, write_level);
+        *record++ = CheckpointBook{book->stock_locate(), {}, book->timestamp(),
+                                   static_cast<uint64_t>(order - first)};
+    }
+    std::memcpy(base, &header, sizeof(header));
+    
+    const bool synced = msync(mapped, header.file_size, MS_SYNC) == 0;
+    munmap(mapped, header.file_size);
+    if (!synced || std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        unlink(temp_path.c_str());
+        throw std::runtime_error("Failed to write checkpoint: " + path);
+    }
+    return CheckpointInfo{sequence, header.symbol_count, header.book_count, header.order_count};
+}
+
+CheckpointInfo BookCheckpoint::load(BookManager& books, const std::string& path) {
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open checkpoint: " + path);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(CheckpointHeader))) {
+        close(fd);
+        throw std::runtime_error("Checkpoint too short: " + path);
+    }
+    const size_t size = static_cast<size_t>(st.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Failed to mmap checkpoint: " + path);
+    }
+    const auto* base = static_cast<const uint8_t*>(mapped);
+    
+    CheckpointHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (header.magic != MAGIC || header.version != VERSION || header.header_size != sizeof(CheckpointHeader) ||
+        header.file_size != size ||
+        !section_fits(header.symbols_offset, header.symbol_count, sizeof(CheckpointSymbol), size) ||
+        !section_fits(header.books_offset, header.book_count, sizeof(CheckpointBook), size) ||
+        !section_fits(header.orders_offset, header.order_count, sizeof(CheckpointOrder), size)) {
+        munmap(mapped, size);
+        throw std::runtime_error("Not a valid book checkpoint: " + path);
+    }
+    
+    books.clear();
+    books.orders_.reserve(header.order_count);
+    books.order_pool_.reserve(header.order_count);
+    
+    const auto* symbol = reinterpret_cast<const CheckpointSymbol*>(base + header.symbols_offset);
+    for (uint64_t i = 0; i < header.symbol_count; ++i) {
+        books.symbols_.add(symbol[i].stock_locate, symbol[i].info);
+    }
+    
+    // Orders are appended in their saved priority, which rebuilds every level
+    const auto* record = reinterpret_cast<const CheckpointBook*>(base + header.books_offset);
+    const auto* order = reinterpret_cast<const CheckpointOrder*>(base + header.orders_offset);
+    const CheckpointOrder* orders_end = order + header.order_count;
+    bool valid = true;
+    for (uint64_t i = 0; i < header.book_count && valid; ++i) {
+        OrderBook& book = books.book_for(record[i].stock_locate);
+        if (record[i].order_count > static_cast<uint64_t>(orders_end - order)) {
+            valid = false;
+            break;
+        }
+        for (const CheckpointOrder* end = order + record[i].order_count; order != end; ++order) {
+            BookOrder* restored = books.order_pool_.create();
+            restored->reference = order->reference;
+            restored->price = order->price;
+            restored->shares = order->shares;
+            restored->stock_locate = record[i].stock_locate;
+            restored->side = order->side ? Side::SELL : Side::BUY;
+            if (order->stock_locate != record[i].stock_locate ||
+                !books.orders_.insert(restored->reference, restored)) {
+                books.order_pool_.destroy(restored);
+                valid = false;
+                break;
+            }
+            book.insert(restored);
+        }
+        books.updated(book, record[i].timestamp);
+    }
+    munmap(mapped, size);
+    
+    if (!valid || order != orders_end) {
+        books.clear();
+        throw std::runtime_error("Corrupt book checkpoint: " + path);
+    }
+    books.stats_ = header.stats;
+    return CheckpointInfo{header.sequence, header.symbol_count, header.book_count, header.order_count};
+}
+
+} // namespace fast_market
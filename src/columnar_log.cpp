@@ -0,0 +1,461 @@
+// Implementation file for the columnar log
+// Column schemas, group output and the footer; append() is inline in the header
+
+#include "columnar_log.hpp"
+#include "system_utils.hpp"
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fast_market {
+
+namespace {
+
+static_assert(sizeof(ColumnarFileHeader) == 64, "Header fills one cache line");
+static_assert(sizeof(RowGroupMeta) == 32, "Footer entries are fixed size");
+
+#define FM_COLUMN(Msg, field) \
+    ColumnSpec{#field, offsetof(Msg, field), sizeof(Msg::field), std::is_integral_v<decltype(Msg::field)>}
+#define FM_HEADER_COLUMNS(Msg)                                                         \
+    ColumnSpec{"timestamp", offsetof(Msg, header.timestamp), sizeof(uint64_t), true},       \
+    ColumnSpec{"stock_locate", offsetof(Msg, header.stock_locate), sizeof(uint16_t), true}, \
+    ColumnSpec{"tracking_number", offsetof(Msg, header.tracking_number), sizeof(uint16_t), true}
+
+constexpr ColumnSpec SYSTEM_EVENT_COLUMNS[] = {
+    FM_HEADER_COLUMNS(SystemEventMessage),
+    FM_COLUMN(SystemEventMessage, event_code),
+};
+
+constexpr ColumnSpec STOCK_DIRECTORY_COLUMNS[] = {
+    FM_HEADER_COLUMNS(StockDirectoryMessage),
+    FM_COLUMN(StockDirectoryMessage, stock),
+    FM_COLUMN(StockDirectoryMessage, market_category),
+    FM_COLUMN(StockDirectoryMessage, financial_status_indicator),
+    FM_COLUMN(StockDirectoryMessage, round_lot_size),
+    FM_COLUMN(StockDirectoryMessage, round_lots_only),
+    FM_COLUMN(StockDirectoryMessage, issue_classification),
+    FM_COLUMN(StockDirectoryMessage, issue_sub_type),
+    FM_COLUMN(StockDirectoryMessage, authenticity),
+    FM_COLUMN(StockDirectoryMessage, short_sale_threshold_indicator),
+    FM_COLUMN(StockDirectoryMessage, ipo_flag),
+    FM_COLUMN(StockDirectoryMessage, luld_reference_price_tier),
+    FM_COLUMN(StockDirectoryMessage, etp_flag),
+    FM_COLUMN(StockDirectoryMessage, etp_leverage_factor),
+    FM_COLUMN(StockDirectoryMessage, inverse_indicator),
+};
+
+constexpr ColumnSpec STOCK_TRADING_ACTION_COLUMNS[] = {
+    FM_HEADER_COLUMNS(StockTradingActionMessage),
+    FM_COLUMN(StockTradingActionMessage, stock),
+    FM_COLUMN(StockTradingActionMessage, trading_state),
+    FM_COLUMN(StockTradingActionMessage, reserved),
+    FM_COLUMN(StockTradingActionMessage, reason),
+};
+
+constexpr ColumnSpec REG_SHO_RESTRICTION_COLUMNS[] = {
+    FM_HEADER_COLUMNS(RegSHORestrictionMessage),
+    FM_COLUMN(RegSHORestrictionMessage, stock),
+    FM_COLUMN(RegSHORestrictionMessage, reg_sho_action),
+};
+
+constexpr ColumnSpec MARKET_PARTICIPANT_POSITION_COLUMNS[] = {
+    FM_HEADER_COLUMNS(MarketParticipantPositionMessage),
+    FM_COLUMN(MarketParticipantPositionMessage, mpid),
+    FM_COLUMN(MarketParticipantPositionMessage, stock),
+    FM_COLUMN(MarketParticipantPositionMessage, primary_market_maker),
+    FM_COLUMN(MarketParticipantPositionMessage, market_maker_mode),
+    FM_COLUMN(MarketParticipantPositionMessage, market_participant_state),
+};
+
+constexpr ColumnSpec MWCB_DECLINE_LEVEL_COLUMNS[] = {
+    FM_HEADER_COLUMNS(MWCBDeclineLevelMessage),
+    FM_COLUMN(MWCBDeclineLevelMessage, level1),
+    FM_COLUMN(MWCBDeclineLevelMessage, level2),
+    FM_COLUMN(MWCBDeclineLevelMessage, level3),
+};
+
+constexpr ColumnSpec MWCB_STATUS_COLUMNS[] = {
+    FM_HEADER_COLUMNS(MWCBStatusMessage),
+    FM_COLUMN(MWCBStatusMessage, breached_level),
+};
+
+constexpr ColumnSpec IPO_QUOTING_PERIOD_COLUMNS[] = {
+    FM_HEADER_COLUMNS(IPOQuotingPeriodMessage),
+    FM_COLUMN(IPOQuotingPeriodMessage, stock),
+    FM_COLUMN(IPOQuotingPeriodMessage, ipo_quotation_release_time),
+    FM_COLUMN(IPOQuotingPeriodMessage, ipo_quotation_release_qualifier),
+    FM_COLUMN(IPOQuotingPeriodMessage, ipo_price),
+};
+
+constexpr ColumnSpec LULD_AUCTION_COLLAR_COLUMNS[] = {
+    FM_HEADER_COLUMNS(LULDAuctionCollarMessage),
+    FM_COLUMN(LULDAuctionCollarMessage, stock),
+    FM_COLUMN(LULDAuctionCollarMessage, auction_collar_reference_price),
+    FM_COLUMN(LULDAuctionCollarMessage, upper_auction_collar_price),
+    FM_COLUMN(LULDAuctionCollarMessage, lower_auction_collar_price),
+    FM_COLUMN(LULDAuctionCollarMessage, auction_collar_extension),
+};
+
+constexpr ColumnSpec OPERATIONAL_HALT_COLUMNS[] = {
+    FM_HEADER_COLUMNS(OperationalHaltMessage),
+    FM_COLUMN(OperationalHaltMessage, stock),
+    FM_COLUMN(OperationalHaltMessage, market_code),
+    FM_COLUMN(OperationalHaltMessage, operational_halt_action),
+};
+
+constexpr ColumnSpec ADD_ORDER_COLUMNS[] = {
+    FM_HEADER_COLUMNS(AddOrderMessage),
+    FM_COLUMN(AddOrderMessage, order_reference_number),
+    FM_COLUMN(AddOrderMessage, buy_sell_indicator),
+    FM_COLUMN(AddOrderMessage, shares),
+    FM_COLUMN(AddOrderMessage, stock),
+    FM_COLUMN(AddOrderMessage, price),
+};
+
+constexpr ColumnSpec ADD_ORDER_MPID_COLUMNS[] = {
+    FM_HEADER_COLUMNS(AddOrderMPIDMessage),
+    FM_COLUMN(AddOrderMPIDMessage, order_reference_number),
+    FM_COLUMN(AddOrderMPIDMessage, buy_sell_indicator),
+    FM_COLUMN(AddOrderMPIDMessage, shares),
+    FM_COLUMN(AddOrderMPIDMessage, stock),
+    FM_COLUMN(AddOrderMPIDMessage, price),
+    FM_COLUMN(AddOrderMPIDMessage, attribution),
+};
+
+constexpr ColumnSpec EXECUTE_ORDER_COLUMNS[] = {
+    FM_HEADER_COLUMNS(ExecuteOrderMessage),
+    FM_COLUMN(ExecuteOrderMessage, order_reference_number),
+    FM_COLUMN(ExecuteOrderMessage, executed_shares),
+    FM_COLUMN(ExecuteOrderMessage, match_number),
+};
+
+constexpr ColumnSpec EXECUTE_ORDER_WITH_PRICE_COLUMNS[] = {
+    FM_HEADER_COLUMNS(ExecuteOrderWithPriceMessage),
+    FM_COLUMN(ExecuteOrderWithPriceMessage, order_reference_number),
+    FM_COLUMN(ExecuteOrderWithPriceMessage, executed_shares),
+    FM_COLUMN(ExecuteOrderWithPriceMessage, match_number),
+    FM_COLUMN(ExecuteOrderWithPriceMessage, printable),
+    FM_COLUMN(ExecuteOrderWithPriceMessage, execution_price),
+};
+
+constexpr ColumnSpec ORDER_CANCEL_COLUMNS[] = {
+    FM_HEADER_COLUMNS(OrderCancelMessage),
+    FM_COLUMN(OrderCancelMessage, order_reference_number),
+    FM_COLUMN(OrderCancelMessage, cancelled_shares),
+};
+
+constexpr ColumnSpec ORDER_DELETE_COLUMNS[] = {
+    FM_HEADER_COLUMNS(OrderDeleteMessage),
+    FM_COLUMN(OrderDeleteMessage, order_reference_number),
+};
+
+constexpr ColumnSpec ORDER_REPLACE_COLUMNS[] = {
+    FM_HEADER_COLUMNS(OrderReplaceMessage),
+    FM_COLUMN(OrderReplaceMessage, original_order_reference_number),
+    FM_COLUMN(OrderReplaceMessage, new_order_reference_number),
+    FM_COLUMN(OrderReplaceMessage, shares),
+    FM_COLUMN(OrderReplaceMessage, price),
+};
+
+constexpr ColumnSpec TRADE_COLUMNS[] = {
+    FM_HEADER_COLUMNS(TradeMessage),
+    FM_COLUMN(TradeMessage, order_reference_number),
+    FM_COLUMN(TradeMessage, buy_sell_indicator),
+    FM_COLUMN(TradeMessage, shares),
+    FM_COLUMN(TradeMessage, stock),
+    FM_COLUMN(TradeMessage, price),
+    FM_COLUMN(TradeMessage, match_number),
+};
+
+constexpr ColumnSpec CROSS_TRADE_COLUMNS[] = {
+    FM_HEADER_COLUMNS(CrossTradeMessage),
+    FM_COLUMN(CrossTradeMessage, shares),
+    FM_COLUMN(CrossTradeMessage, stock),
+    FM_COLUMN(CrossTradeMessage, cross_price),
+    FM_COLUMN(CrossTradeMessage, match_number),
+    FM_COLUMN(CrossTradeMessage, cross_type),
+};
+
+constexpr ColumnSpec BROKEN_TRADE_COLUMNS[] = {
+    FM_HEADER_COLUMNS(BrokenTradeMessage),
+    FM_COLUMN(BrokenTradeMessage, match_number),
+};
+
+constexpr ColumnSpec NOII_COLUMNS[] = {
+    FM_HEADER_COLUMNS(NOIIMessage),
+    FM_COLUMN(NOIIMessage, paired_shares),
+    FM_COLUMN(NOIIMessage, imbalance_shares),
+    FM_COLUMN(NOIIMessage, imbalance_direction),
+    FM_COLUMN(NOIIMessage, stock),
+    FM_COLUMN(NOIIMessage, far_price),
+    FM_COLUMN(NOIIMessage, near_price),
+    FM_COLUMN(NOIIMessage, current_reference_price),
+    FM_COLUMN(NOIIMessage, cross_type),
+    FM_COLUMN(NOIIMessage, price_variation_indicator),
+};
+
+constexpr ColumnSpec RPII_COLUMNS[] = {
+    FM_HEADER_COLUMNS(RPIIMessage),
+    FM_COLUMN(RPIIMessage, stock),
+    FM_COLUMN(RPIIMessage, interest_flag),
+};
+
+constexpr ColumnSpec DLCR_PRICE_DISCOVERY_COLUMNS[] = {
+    FM_HEADER_COLUMNS(DLCRPriceDiscoveryMessage),
+    FM_COLUMN(DLCRPriceDiscoveryMessage, stock),
+    FM_COLUMN(DLCRPriceDiscoveryMessage, open_eligibility_status),
+    FM_COLUMN(DLCRPriceDiscoveryMessage, minimum_allowable_price),
+    FM_COLUMN(DLCRPriceDiscoveryMessage, maximum_allowable_price),
+    FM_COLUMN(DLCRPriceDiscoveryMessage, near_execution_price),
+    FM_COLUMN(DLCRPriceDiscoveryMessage, near_execution_time),
+    FM_COLUMN(DLCRPriceDiscoveryMessage, lower_price_range_collar),
+    FM_COLUMN(DLCRPriceDiscoveryMessage, upper_price_range_collar),
+};
+
+#undef FM_HEADER_COLUMNS
+#undef FM_COLUMN
+
+template<size_t N>
+constexpr ColumnSchema schema_of(const ColumnSpec (&columns)[N]) noexcept {
+    static_assert(N <= ColumnarWriter::MAX_COLUMNS, "Raise MAX_COLUMNS");
+    return ColumnSchema{columns, N};
+}
+
+// Column chunks start 8-byte aligned within a group
+constexpr size_t chunk_bytes(size_t rows, size_t value_size) noexcept {
+    return (rows * value_size + 7) & ~size_t{7};
+}
+
+size_t group_bytes(const ColumnSchema& schema, size_t rows) noexcept {
+    size_t bytes = 0;
+    for (size_t i = 0; i < schema.count; ++i) {
+        bytes += chunk_bytes(rows, schema.columns[i].size);
+    }
+    return bytes;
+}
+
+} // namespace
+
+ColumnSchema columnar_schema(MessageType type) noexcept {
+    switch (type) {
+        case MessageType::SYSTEM_EVENT:                return schema_of(SYSTEM_EVENT_COLUMNS);
+        case MessageType::STOCK_DIRECTORY:             return schema_of(STOCK_DIRECTORY_COLUMNS);
+        case MessageType::STOCK_TRADING_ACTION:        return schema_of(STOCK_TRADING_ACTION_COLUMNS);
+        case MessageType::REG_SHO_RESTRICTION:         return schema_of(REG_SHO_RESTRICTION_COLUMNS);
+        case MessageType::MARKET_PARTICIPANT_POSITION: return schema_of(MARKET_PARTICIPANT_POSITION_COLUMNS);
+        case MessageType::MWCB_DECLINE_LEVEL:          return schema_of(MWCB_DECLINE_LEVEL_COLUMNS);
+        case MessageType::MWCB_STATUS:                 return schema_of(MWCB_STATUS_COLUMNS);
+        case MessageType::IPO_QUOTING_PERIOD:          return schema_of(IPO_QUOTING_PERIOD_COLUMNS);
+        case MessageType::LULD_AUCTION_COLLAR:         return schema_of(LULD_AUCTION_COLLAR_COLUMNS);
+        case MessageType::OPERATIONAL_HALT:            return schema_of(OPERATIONAL_HALT_COLUMNS);
+        case MessageType::ADD_ORDER:                   return schema_of(ADD_ORDER_COLUMNS);
+        case MessageType::ADD_ORDER_MPID:              return schema_of(ADD_ORDER_MPID_COLUMNS);
+        case MessageType::EXECUTE_ORDER:               return schema_of(EXECUTE_ORDER_COLUMNS);
+        case MessageType::EXECUTE_ORDER_WITH_PRICE:    return schema_of(EXECUTE_ORDER_WITH_PRICE_COLUMNS);
+        case MessageType::ORDER_CANCEL:                return schema_of(ORDER_CANCEL_COLUMNS);
+        case MessageType::ORDER_DELETE:                return schema_of(ORDER_DELETE_COLUMNS);
+        case MessageType::ORDER_REPLACE:               return schema_of(ORDER_REPLACE_COLUMNS);
+        case MessageType::TRADE:                       return schema_of(TRADE_COLUMNS);
+        case MessageType::CROSS_TRADE:                 return schema_of(CROSS_TRADE_COLUMNS);
+        case MessageType::BROKEN_TRADE:                return schema_of(BROKEN_TRADE_COLUMNS);
+        case MessageType::NOII:                        return schema_of(NOII_COLUMNS);
+        case MessageType::RPII:                        return schema_of(RPII_COLUMNS);
+        case MessageType::DLCR_PRICE_DISCOVERY:        return schema_of(DLCR_PRICE_DISCOVERY_COLUMNS);
+    }
+    return ColumnSchema{};
+}
+
+ColumnarWriter::ColumnarWriter(int fd, size_t rows_per_group)
+    : fd_(fd)
+    , rows_per_group_(rows_per_group)
+{
+    // Full groups then have every chunk 64-byte aligned and need no compaction
+    if (rows_per_group == 0 || rows_per_group % 64 != 0 || rows_per_group > UINT32_MAX) {
+        throw std::invalid_argument("rows_per_group must be a non-zero multiple of 64");
+    }
+    ColumnarFileHeader header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.rows_per_group = static_cast<uint32_t>(rows_per_group);
+    write_bytes(&header, sizeof(header));
+}
+
+ColumnarWriter::~ColumnarWriter() {
+    for (TypeBuffer& buffer : buffers_) {
+        SystemUtils::free_large(buffer.data, buffer.size);
+    }
+}
+
+bool ColumnarWriter::open_buffer(TypeBuffer& buffer, MessageType type) {
+    const ColumnSchema schema = columnar_schema(type);
+    if (schema.count == 0 || finished_) {
+        return false;
+    }
+    size_t offset = 0;
+    for (size_t i = 0; i < schema.count; ++i) {
+        buffer.column_offsets[i] = offset;
+        offset += chunk_bytes(rows_per_group_, schema.columns[i].size);
+    }
+    buffer.data = static_cast<uint8_t*>(SystemUtils::allocate_large(offset));
+    if (buffer.data == nullptr) {
+        ok_ = false;
+        return false;
+    }
+    buffer.size = offset;
+    buffer.schema = schema;
+    buffer.message_type = static_cast<uint8_t>(type);
+    return true;
+}
+
+void ColumnarWriter::write_group(TypeBuffer& buffer) {
+    // A partial group is compacted in place: each chunk moves down to follow
+    // the previous one, which never overlaps a chunk not yet moved
+    size_t bytes = 0;
+    for (size_t i = 0; i < buffer.schema.count; ++i) {
+        const size_t used = buffer.rows * buffer.schema.columns[i].size;
+        if (bytes != buffer.column_offsets[i]) {
+            std::memmove(buffer.data + bytes, buffer.data + buffer.column_offsets[i], used);
+        }
+        std::memset(buffer.data + bytes + used, 0, chunk_bytes(buffer.rows, buffer.schema.columns[i].size) - used);
+        bytes += chunk_bytes(buffer.rows, buffer.schema.columns[i].size);
+    }
+    
+    pad_to(64);
+    RowGroupMeta meta{};
+    meta.offset = file_offset_;
+    meta.first_timestamp = buffer.first_timestamp;
+    meta.last_timestamp = buffer.last_timestamp;
+    meta.rows = static_cast<uint32_t>(buffer.rows);
+    meta.message_type = buffer.message_type;
+    meta.column_count = static_cast<uint8_t>(buffer.schema.count);
+    footer_.push_back(meta);
+    
+    write_bytes(buffer.data, bytes);
+    rows_written_ += buffer.rows;
+    buffer.rows = 0;
+}
+
+void ColumnarWriter::finish() {
+    if (finished_) {
+        return;
+    }
+    for (TypeBuffer& buffer : buffers_) {
+        if (buffer.rows != 0) {
+            write_group(buffer);
+        }
+    }
+    finished_ = true;
+    
+    pad_to(8);
+    ColumnarTrailer trailer{file_offset_, footer_.size(), MAGIC};
+    write_bytes(footer_.data(), footer_.size() * sizeof(RowGroupMeta));
+    write_bytes(&trailer, sizeof(trailer));
+}
+
+void ColumnarWriter::write_bytes(const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    while (size != 0 && ok_) {
+        const ssize_t written = ::write(fd_, bytes, size);
+        if (written <= 0) {
+            ok_ = false;
+            break;
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+        file_offset_ += static_cast<uint64_t>(written);
+    }
+}
+
+void ColumnarWriter::pad_to(uint64_t alignment) {
+    static constexpr uint8_t ZEROS[64] = {};
+    const uint64_t padding = (alignment - file_offset_ % alignment) % alignment;
+    write_bytes(ZEROS, padding);
+}
+
+ColumnarLogReader::ColumnarLogReader(const std::string& path) {
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open columnar log: " + path);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 ||
+        st.st_size < static_cast<off_t>(sizeof(ColumnarFileHeader) + sizeof(ColumnarTrailer))) {
+        close(fd);
+        throw std::runtime_error("Columnar log too short: " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Failed to mmap columnar log: " + path);
+    }
+    base_ = static_cast<const uint8_t*>(mapped);
+    
+    ColumnarFileHeader header;
+    ColumnarTrailer trailer;
+    std::memcpy(&header, base_, sizeof(header));
+    std::memcpy(&trailer, base_ + size_ - sizeof(trailer), sizeof(trailer));
+    const size_t footer_end = size_ - sizeof(trailer);
+    bool valid = header.magic == ColumnarWriter::MAGIC && header.version == ColumnarWriter::VERSION &&
+                 trailer.magic == ColumnarWriter::MAGIC && trailer.footer_offset <= footer_end &&
+                 trailer.row_group_count == (footer_end - trailer.footer_offset) / sizeof(RowGroupMeta);
+    if (valid) {
+        groups_.resize(trailer.row_group_count);
+        std::memcpy(groups_.data(), base_ + trailer.footer_offset, groups_.size() * sizeof(RowGroupMeta));
+        for (const RowGroupMeta& group : groups_) {
+            const ColumnSchema schema = columnar_schema(static_cast<MessageType>(group.message_type));
+            valid = valid && schema.count != 0 && schema.count == group.column_count &&
+                    group.offset <= trailer.footer_offset &&
+                    group_bytes(schema, group.rows) <= trailer.footer_offset - group.offset;
+        }
+    }
+    if (!valid) {
+        munmap(mapped, size_);
+        throw std::runtime_error("Not a valid columnar log: " + path);
+    }
+    madvise(mapped, size_, MADV_SEQUENTIAL);
+}
+
+ColumnarLogReader::~ColumnarLogReader() {
+    munmap(const_cast<uint8_t*>(base_), size_);
+}
+
+int ColumnarLogReader::column_index(MessageType type, std::string_view name) noexcept {
+    const ColumnSchema schema = columnar_schema(type);
+    for (size_t i = 0; i < schema.count; ++i) {
+        if (name == schema.columns[i].name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+size_t ColumnarLogReader::column_offset(size_t group, size_t column) const noexcept {
+    const RowGroupMeta& meta = groups_[group];
+    const ColumnSchema schema = columnar_schema(static_cast<MessageType>(meta.message_type));
+    size_t offset = meta.offset;
+    for (size_t i = 0; i < column; ++i) {
+        offset += chunk_bytes(meta.rows, schema.columns[i].size);
+    }
+    return offset;
+}
+
+size_t ColumnarLogReader::column_bytes(size_t group, size_t column) const noexcept {
+    const RowGroupMeta& meta = groups_[group];
+    const ColumnSchema schema = columnar_schema(static_cast<MessageType>(meta.message_type));
+    return chunk_bytes(meta.rows, schema.columns[column].size);
+}
+
+uint64_t ColumnarLogReader::rows(MessageType type) const noexcept {
+    uint64_t total = 0;
+    for (const RowGroupMeta& group : groups_) {
+        total += group.message_type == static_cast<uint8_t>(type) ? group.rows : 0;
+    }
+    return total;
+}
+
+} // namespace fast_market
@@ -0,0 +1,113 @@
+// Implementation file for the compact log
+// Field plans and file mapping; encode/decode are inline in the header
+
+#include "compact_log.hpp"
+#include <algorithm>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fast_market {
+
+namespace {
+
+static_assert(sizeof(CompactLogHeader) == 16, "Header is fixed size");
+
+bool is_sequence_field(std::string_view name) noexcept {
+    return name == "order_reference_number" || name == "original_order_reference_number" ||
+           name == "new_order_reference_number" || name == "match_number";
+}
+
+std::array<CompactPlan, 256> build_plans() noexcept {
+    std::array<CompactPlan, 256> plans{};
+    for (size_t type = 0; type < plans.size(); ++type) {
+        const ColumnSchema schema = columnar_schema(static_cast<MessageType>(type));
+        CompactPlan& plan = plans[type];
+        for (size_t i = 0; i < schema.count; ++i) {
+            const ColumnSpec& column = schema.columns[i];
+            CompactField kind = CompactField::RAW;
+            if (i == 0) {
+                kind = CompactField::TIMESTAMP;
+            } else if (is_sequence_field(column.name)) {
+                kind = CompactField::DELTA;
+            } else if (std::string_view(column.name) == "stock") {
+                kind = CompactField::SYMBOL;
+            } else if (column.integer && column.size > 1) {
+                kind = CompactField::VARINT;
+            }
+            plan.fields[i] = CompactFieldPlan{column.offset, static_cast<uint8_t>(column.size), kind};
+        }
+        plan.count = schema.count;
+    }
+    return plans;
+}
+
+} // namespace
+
+const std::array<CompactPlan, 256>& compact_plans() noexcept {
+    static const std::array<CompactPlan, 256> plans = build_plans();
+    return plans;
+}
+
+CompactEncoder::CompactEncoder()
+    : plans_(&compact_plans())
+    , symbols_(MAX_LOCATES)
+{
+}
+
+void CompactEncoder::reset() noexcept {
+    previous_ = {};
+    if (++generation_ == 0) {
+        std::fill(symbols_.begin(), symbols_.end(), KnownSymbol{});
+        generation_ = 1;
+    }
+}
+
+CompactDecoder::CompactDecoder()
+    : plans_(&compact_plans())
+    , symbols_(CompactEncoder::MAX_LOCATES)
+{
+}
+
+void CompactDecoder::reset() noexcept {
+    previous_ = {};
+    if (++generation_ == 0) {
+        std::fill(symbols_.begin(), symbols_.end(), CompactEncoder::KnownSymbol{});
+        generation_ = 1;
+    }
+}
+
+CompactLogReader::CompactLogReader(const std::string& path) {
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open compact log: " + path);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(CompactLogHeader))) {
+        close(fd);
+        throw std::runtime_error("Compact log too short: " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Failed to mmap compact log: " + path);
+    }
+    base_ = static_cast<const uint8_t*>(mapped);
+    
+    CompactLogHeader header;
+    std::memcpy(&header, base_, sizeof(header));
+    if (header.magic != CompactEncoder::MAGIC || header.version != CompactEncoder::VERSION) {
+        munmap(mapped, size_);
+        throw std::runtime_error("Not a compact log: " + path);
+    }
+    madvise(mapped, size_, MADV_SEQUENTIAL);
+}
+
+CompactLogReader::~CompactLogReader() {
+    munmap(const_cast<uint8_t*>(base_), size_);
+}
+
+} // namespace fast_market
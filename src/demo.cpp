@@ -21,7 +21,7 @@ public:
         order->header.message_type = static_cast<uint8_t>(MessageType::ADD_ORDER);
         order->header.stock_locate = hton16(1);
         order->header.tracking_number = hton16(seq_++);
-        order->header.timestamp = hton64(get_itch_timestamp());
+        order->header.timestamp = hton48(get_itch_timestamp());
         
         order->order_reference_number = hton64(100000 + seq_);
         order->buy_sell_indicator = side;
@@ -45,7 +45,7 @@ public:
         trade->header.message_type = static_cast<uint8_t>(MessageType::TRADE);
         trade->header.stock_locate = hton16(1);
         trade->header.tracking_number = hton16(seq_++);
-        trade->header.timestamp = hton64(get_itch_timestamp());
+        trade->header.timestamp = hton48(get_itch_timestamp());
         
         trade->order_reference_number = hton64(100000 + seq_);
         trade->buy_sell_indicator = side;
@@ -66,8 +66,8 @@ private:
         // ITCH timestamp is nanoseconds since midnight
         auto now = std::chrono::system_clock::now();
         auto duration = now.time_since_epoch();
-        auto midnight = duration - std::chrono::hours(24);  // Approximate
-        return std::chrono::duration_cast<std::chrono::nanoseconds>(midnight).count();
+        auto since_midnight = duration % std::chrono::hours(24);  // UTC midnight
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(since_midnight).count();
     }
     
     uint16_t hton16(uint16_t x) { return __builtin_bswap16(x); }
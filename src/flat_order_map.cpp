@@ -0,0 +1,10 @@
+// Implementation file for the flat order map
+// All functionality is template-based and inline in the header
+
+#include "flat_order_map.hpp"
+
+namespace fast_market {
+
+// Template implementations are in the header
+
+} // namespace fast_market
@@ -0,0 +1,190 @@
+// Implementation file for the streaming gzip reader
+// The decompression thread lives here; the parse loop is inline
+
+#include "gzip_stream.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+
+namespace fast_market {
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start) noexcept {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+GzipStreamReader::GzipStreamReader(const std::string& path, size_t block_size, size_t block_count)
+    : block_size_((std::max<size_t>(block_size, 1) + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1))
+{
+    fd_ = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+    posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+    
+    // Two blocks minimum so inflate and parse can overlap at all
+    blocks_.resize(std::max<size_t>(block_count, 2));
+    for (auto& block : blocks_) {
+        block.data = static_cast<uint8_t*>(std::aligned_alloc(BLOCK_ALIGNMENT, block_size_));
+        if (!block.data) {
+            for (auto& allocated : blocks_) {
+                std::free(allocated.data);
+            }
+            close(fd_);
+            throw std::runtime_error("Failed to allocate gzip stream blocks");
+        }
+    }
+}
+
+GzipStreamReader::~GzipStreamReader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    freed_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    for (auto& block : blocks_) {
+        std::free(block.data);
+    }
+    close(fd_);
+}
+
+void GzipStreamReader::start() {
+    if (!thread_.joinable()) {
+        thread_ = std::thread([this] { decompress_loop(); });
+    }
+}
+
+bool GzipStreamReader::next(DecompressedBlock& block) {
+    start();
+    release();
+    
+    const auto start_wait = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(mutex_);
+    ready_.wait(lock, [this] { return produced_ != consumed_ || finished_; });
+    stats_.consumer_wait_seconds += seconds_since(start_wait);
+    if (produced_ == consumed_) {
+        return false;
+    }
+    
+    const Block& ready = blocks_[consumed_ % blocks_.size()];
+    block.data = ready.data;
+    block.size = ready.size;
+    holding_ = true;
+    return true;
+}
+
+void GzipStreamReader::release() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!holding_) {
+            return;
+        }
+        holding_ = false;
+        ++consumed_;
+    }
+    freed_.notify_one();
+}
+
+void GzipStreamReader::fail(const char* message) noexcept {
+    error_ = message;
+    failed_.store(true, std::memory_order_release);
+}
+
+void GzipStreamReader::decompress_loop() noexcept {
+    z_stream zs{};
+    // 15 + 32: maximum window, detect the gzip (or zlib) header
+    if (inflateInit2(&zs, 15 + 32) != Z_OK) {
+        fail("inflateInit2 failed");
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_ = true;
+        ready_.notify_one();
+        return;
+    }
+    
+    std::vector<uint8_t> input(READ_SIZE);
+    bool input_eof = false;
+    bool member_open = false;   // Inside a gzip member that has not ended yet
+    bool done = false;
+    
+    while (!done) {
+        // Wait for a free block
+        Block* block;
+        {
+            const auto start_wait = std::chrono::steady_clock::now();
+            std::unique_lock<std::mutex> lock(mutex_);
+            freed_.wait(lock, [this] { return produced_ - consumed_ < blocks_.size() || stopping_; });
+            stats_.producer_wait_seconds += seconds_since(start_wait);
+            if (stopping_) {
+                break;
+            }
+            block = &blocks_[produced_ % blocks_.size()];
+        }
+        
+        const auto start_fill = std::chrono::steady_clock::now();
+        zs.next_out = block->data;
+        zs.avail_out = static_cast<uInt>(block_size_);
+        while (zs.avail_out > 0) {
+            if (zs.avail_in == 0 && !input_eof) {
+                const ssize_t n = read(fd_, input.data(), input.size());
+                if (n < 0) {
+                    fail("Read error on gzip input");
+                    done = true;
+                    break;
+                }
+                input_eof = (n == 0);
+                zs.next_in = input.data();
+                zs.avail_in = static_cast<uInt>(n);
+                stats_.compressed_bytes += static_cast<uint64_t>(n);
+            }
+            if (zs.avail_in == 0) {
+                if (member_open) {
+                    fail("Truncated gzip stream");
+                }
+                done = true;
+                break;
+            }
+            
+            // Another member follows the one that just ended
+            if (!member_open) {
+                inflateReset(&zs);
+                member_open = true;
+            }
+            
+            const int rc = inflate(&zs, Z_NO_FLUSH);
+            if (rc == Z_STREAM_END) {
+                member_open = false;
+            } else if (rc != Z_OK && rc != Z_BUF_ERROR) [[unlikely]] {
+                fail(zs.msg ? zs.msg : "Corrupt gzip stream");
+                done = true;
+                break;
+            }
+        }
+        
+        const size_t filled = block_size_ - zs.avail_out;
+        stats_.decompressed_bytes += filled;
+        stats_.decompress_seconds += seconds_since(start_fill);
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (filled > 0) {
+                block->size = filled;
+                ++produced_;
+            }
+            finished_ = done;
+        }
+        ready_.notify_one();
+    }
+    
+    inflateEnd(&zs);
+}
+
+} // namespace fast_market
@@ -0,0 +1,176 @@
+// Implementation file for the batch header decoder
+// Kernels are compiled per instruction set with target attributes so the
+// library still runs on CPUs without AVX2/AVX-512
+
+#include "header_decoder.hpp"
+#include "itch_views.hpp"
+#include <immintrin.h>
+#include <cstring>
+
+namespace fast_market {
+
+namespace {
+
+// Every kernel loads 16 bytes from the start of each message
+constexpr size_t VECTOR_LOAD_SIZE = 16;
+
+void decode_scalar(const uint8_t* data, const uint32_t* offsets, size_t begin, size_t end,
+                   const HeaderColumns& out) noexcept {
+    for (size_t i = begin; i < end; ++i) {
+        HeaderView header(data + offsets[i]);
+        out.message_type[i] = static_cast<uint8_t>(header.type());
+        out.stock_locate[i] = header.stock_locate();
+        out.tracking_number[i] = header.tracking_number();
+        out.timestamp[i] = header.timestamp();
+    }
+}
+
+[[gnu::always_inline]] inline __m128i load_header(const uint8_t* data, uint32_t offset) noexcept {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+}
+
+// Per 128-bit lane, rearranges one wire header into
+//   bytes 0-7   timestamp, little-endian, top 2 bytes zeroed
+//   bytes 8-9   stock_locate, little-endian
+//   bytes 10-11 tracking_number, little-endian
+//   byte  12    message_type
+#define HEADER_SHUFFLE_LANE \
+    10, 9, 8, 7, 6, 5, -128, -128, 2, 1, 4, 3, 0, -128, -128, -128
+
+__attribute__((target("avx2")))
+void decode_avx2(const uint8_t* data, const uint32_t* offsets, size_t count,
+                 const HeaderColumns& out) noexcept {
+    const __m256i header_shuffle = _mm256_setr_epi8(HEADER_SHUFFLE_LANE, HEADER_SHUFFLE_LANE);
+    
+    // Lane holds [meta(first msg) | meta(second msg)] after the unpack;
+    // collect locates into dword 0 and tracking numbers into dword 1
+    const __m256i meta_shuffle = _mm256_setr_epi8(
+        0, 1, 8, 9, 2, 3, 10, 11, 4, 12, -128, -128, -128, -128, -128, -128,
+        0, 1, 8, 9, 2, 3, 10, 11, 4, 12, -128, -128, -128, -128, -128, -128);
+    const __m256i meta_permute = _mm256_setr_epi32(0, 4, 1, 5, 0, 0, 0, 0);
+    
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        // a = [m0 | m2], b = [m1 | m3] so the 64-bit unpacks come out in order
+        const __m128i m0 = load_header(data, offsets[i]);
+        const __m128i m1 = load_header(data, offsets[i + 1]);
+        const __m128i m2 = load_header(data, offsets[i + 2]);
+        const __m128i m3 = load_header(data, offsets[i + 3]);
+        
+        __m256i a = _mm256_inserti128_si256(_mm256_castsi128_si256(m0), m2, 1);
+        __m256i b = _mm256_inserti128_si256(_mm256_castsi128_si256(m1), m3, 1);
+        a = _mm256_shuffle_epi8(a, header_shuffle);
+        b = _mm256_shuffle_epi8(b, header_shuffle);
+        
+        const __m256i timestamps = _mm256_unpacklo_epi64(a, b);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.timestamp + i), timestamps);
+        
+        __m256i meta = _mm256_unpackhi_epi64(a, b);
+        meta = _mm256_shuffle_epi8(meta, meta_shuffle);
+        
+        const uint32_t types = static_cast<uint32_t>(_mm256_extract_epi16(meta, 4))
+                             | (static_cast<uint32_t>(_mm256_extract_epi16(meta, 12)) << 16);
+        std::memcpy(out.message_type + i, &types, sizeof(types));
+        
+        const __m128i ids = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(meta, meta_permute));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out.stock_locate + i), ids);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out.tracking_number + i), _mm_unpackhi_epi64(ids, ids));
+    }
+    
+    decode_scalar(data, offsets, i, count, out);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+void decode_avx512(const uint8_t* data, const uint32_t* offsets, size_t count,
+                   const HeaderColumns& out) noexcept {
+    // Zero-masked forms with a full mask throughout: GCC's unmasked
+    // wrappers merge into an uninitialized vector and warn under -Wall
+    constexpr __mmask8 all_lanes = 0xFF;
+    const __m512i header_shuffle = _mm512_maskz_broadcast_i32x4(
+        0xFFFF, _mm_setr_epi8(HEADER_SHUFFLE_LANE));
+    
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        // a = [m0 m2 m4 m6], b = [m1 m3 m5 m7]
+        // (load_header is force-inlined: an out-of-line SSE call between
+        // 512-bit ops pays AVX/SSE transition penalties in unoptimized builds)
+        __m512i a = _mm512_castsi128_si512(load_header(data, offsets[i]));
+        a = _mm512_inserti32x4(a, load_header(data, offsets[i + 2]), 1);
+        a = _mm512_inserti32x4(a, load_header(data, offsets[i + 4]), 2);
+        a = _mm512_inserti32x4(a, load_header(data, offsets[i + 6]), 3);
+        __m512i b = _mm512_castsi128_si512(load_header(data, offsets[i + 1]));
+        b = _mm512_inserti32x4(b, load_header(data, offsets[i + 3]), 1);
+        b = _mm512_inserti32x4(b, load_header(data, offsets[i + 5]), 2);
+        b = _mm512_inserti32x4(b, load_header(data, offsets[i + 7]), 3);
+        
+        a = _mm512_shuffle_epi8(a, header_shuffle);
+        b = _mm512_shuffle_epi8(b, header_shuffle);
+        
+        _mm512_storeu_si512(out.timestamp + i, _mm512_maskz_unpacklo_epi64(all_lanes, a, b));
+        
+        // One 64-bit meta word per message: locate | tracking << 16 | type << 32
+        const __m512i meta = _mm512_maskz_unpackhi_epi64(all_lanes, a, b);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out.stock_locate + i),
+                         _mm512_maskz_cvtepi64_epi16(all_lanes, meta));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out.tracking_number + i),
+                         _mm512_maskz_cvtepi64_epi16(all_lanes, _mm512_maskz_srli_epi64(all_lanes, meta, 16)));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out.message_type + i),
+                         _mm512_maskz_cvtepi64_epi8(all_lanes, _mm512_maskz_srli_epi64(all_lanes, meta, 32)));
+    }
+    
+    decode_avx2(data, offsets + i, count - i,
+                HeaderColumns{out.message_type + i, out.stock_locate + i,
+                              out.tracking_number + i, out.timestamp + i});
+}
+
+#undef HEADER_SHUFFLE_LANE
+
+SimdLevel detect_simd_level() noexcept {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+    return SimdLevel::SCALAR;
+}
+
+} // namespace
+
+SimdLevel BatchHeaderDecoder::best_available() noexcept {
+    static const SimdLevel level = detect_simd_level();
+    return level;
+}
+
+void BatchHeaderDecoder::decode(const uint8_t* data, size_t length, const uint32_t* offsets,
+                                size_t count, const HeaderColumns& out) noexcept {
+    decode(best_available(), data, length, offsets, count, out);
+}
+
+void BatchHeaderDecoder::decode(SimdLevel level, const uint8_t* data, size_t length,
+                                const uint32_t* offsets, size_t count,
+                                const HeaderColumns& out) noexcept {
+    // Messages whose 16-byte load would run past the buffer take the
+    // scalar path; offsets are ascending so they are all at the tail
+    size_t vector_count = count;
+    while (vector_count > 0 && offsets[vector_count - 1] + VECTOR_LOAD_SIZE > length) {
+        --vector_count;
+    }
+    
+    switch (level) {
+        case SimdLevel::AVX512:
+            decode_avx512(data, offsets, vector_count, out);
+            break;
+        case SimdLevel::AVX2:
+            decode_avx2(data, offsets, vector_count, out);
+            break;
+        case SimdLevel::SCALAR:
+            decode_scalar(data, offsets, 0, vector_count, out);
+            break;
+    }
+    
+    decode_scalar(data, offsets, vector_count, count, out);
+}
+
+} // namespace fast_market
@@ -0,0 +1,136 @@
+// Implementation file for the log index
+// Sidecar file I/O and binary search; scans are inline in the header
+
+#include "log_index.hpp"
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fast_market {
+
+namespace {
+
+static_assert(sizeof(LogIndexHeader) == 32, "Header is fixed size");
+static_assert(sizeof(LogIndexEntry) == 24, "Entries are fixed size");
+
+bool write_all(int fd, const void* data, size_t size) noexcept {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    while (size != 0) {
+        const ssize_t written = ::write(fd, bytes, size);
+        if (written <= 0) {
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+} // namespace
+
+LogIndexWriter::LogIndexWriter(const std::string& path, LogFormat format, uint64_t every_records, uint64_t every_ns)
+    : every_records_(every_records)
+    , every_ns_(every_ns)
+{
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw std::runtime_error("Failed to create log index: " + path);
+    }
+    const LogIndexHeader header{MAGIC, VERSION, format, every_records, every_ns};
+    if (!write_all(fd_, &header, sizeof(header))) {
+        ::close(fd_);
+        throw std::runtime_error("Failed to write log index: " + path);
+    }
+    entries_.reserve(BLOCK_ENTRIES);
+}
+
+LogIndexWriter::~LogIndexWriter() {
+    close();
+}
+
+void LogIndexWriter::write_entries() {
+    // An index with a lost block still seeks correctly, just less closely
+    write_all(fd_, entries_.data(), entries_.size() * sizeof(LogIndexEntry));
+    entries_.clear();
+}
+
+void LogIndexWriter::close() {
+    if (fd_ < 0) {
+        return;
+    }
+    write_entries();
+    ::close(fd_);
+    fd_ = -1;
+}
+
+IndexedLogReader::IndexedLogReader(const std::string& log_path) {
+    const std::string index_path = log_path + ".idx";
+    const int index_fd = ::open(index_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (index_fd < 0) {
+        throw std::runtime_error("Failed to open log index: " + index_path);
+    }
+    struct stat st;
+    LogIndexHeader header{};
+    const bool readable = fstat(index_fd, &st) == 0 && st.st_size >= static_cast<off_t>(sizeof(header)) &&
+                          ::pread(index_fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+    const size_t count = readable ? (static_cast<size_t>(st.st_size) - sizeof(header)) / sizeof(LogIndexEntry) : 0;
+    entries_.resize(count);
+    const ssize_t bytes = static_cast<ssize_t>(count * sizeof(LogIndexEntry));
+    const bool loaded = readable && ::pread(index_fd, entries_.data(), bytes, sizeof(header)) == bytes;
+    ::close(index_fd);
+    if (!loaded || header.magic != LogIndexWriter::MAGIC || header.version != LogIndexWriter::VERSION ||
+        (header.format != LogFormat::ROW && header.format != LogFormat::COMPACT) || entries_.empty()) {
+        throw std::runtime_error("Not a valid log index: " + index_path);
+    }
+    format_ = header.format;
+    
+    const int fd = ::open(log_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open log: " + log_path);
+    }
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        throw std::runtime_error("Log is empty: " + log_path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Failed to mmap log: " + log_path);
+    }
+    base_ = static_cast<const uint8_t*>(mapped);
+    
+    // Entries past the end of the log (e.g. a log cut short) are unusable
+    while (!entries_.empty() && entries_.back().offset >= size_) {
+        entries_.pop_back();
+    }
+    if (entries_.empty()) {
+        munmap(mapped, size_);
+        throw std::runtime_error("Log index does not match log: " + log_path);
+    }
+    madvise(mapped, size_, MADV_RANDOM);
+}
+
+IndexedLogReader::~IndexedLogReader() {
+    munmap(const_cast<uint8_t*>(base_), size_);
+}
+
+const LogIndexEntry& IndexedLogReader::seek_time(uint64_t timestamp) const noexcept {
+    const auto it = std::lower_bound(entries_.begin(), entries_.end(), timestamp,
+                                     [](const LogIndexEntry& entry, uint64_t value) {
+                                         return entry.timestamp < value;
+                                     });
+    return it == entries_.begin() ? entries_.front() : *(it - 1);
+}
+
+const LogIndexEntry& IndexedLogReader::seek_ordinal(uint64_t ordinal) const noexcept {
+    const auto it = std::upper_bound(entries_.begin(), entries_.end(), ordinal,
+                                     [](uint64_t value, const LogIndexEntry& entry) {
+                                         return value < entry.ordinal;
+                                     });
+    return it == entries_.begin() ? entries_.front() : *(it - 1);
+}
+
+} // namespace fast_market
@@ -0,0 +1,53 @@
+// Implementation file for the mirrored ring buffer
+// Only setup and teardown live here; the accessors are inline
+
+#include "mirrored_ring.hpp"
+#include <stdexcept>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace fast_market {
+
+MirroredRingBuffer::MirroredRingBuffer(size_t min_capacity) {
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    capacity_ = page;
+    while (capacity_ < min_capacity) {
+        capacity_ <<= 1;
+    }
+    mask_ = capacity_ - 1;
+    
+    const int fd = memfd_create("fast_market_ring", MFD_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to create ring memfd");
+    }
+    if (ftruncate(fd, static_cast<off_t>(capacity_)) != 0) {
+        close(fd);
+        throw std::runtime_error("Failed to size ring memfd");
+    }
+    
+    // Reserve twice the span, then map the same pages into both halves
+    void* reserved = mmap(nullptr, 2 * capacity_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved == MAP_FAILED) {
+        close(fd);
+        throw std::runtime_error("Failed to reserve ring address space");
+    }
+    
+    base_ = static_cast<uint8_t*>(reserved);
+    const bool mapped =
+        mmap(base_, capacity_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED &&
+        mmap(base_ + capacity_, capacity_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+    close(fd);  // The mappings keep the memory alive
+    
+    if (!mapped) {
+        munmap(base_, 2 * capacity_);
+        throw std::runtime_error("Failed to mirror ring mapping");
+    }
+}
+
+MirroredRingBuffer::~MirroredRingBuffer() {
+    if (base_) {
+        munmap(base_, 2 * capacity_);
+    }
+}
+
+} // namespace fast_market
@@ -0,0 +1,10 @@
+// Implementation file for the MoldUDP64 decoder
+// The per-packet path is inline in the header
+
+#include "moldudp64.hpp"
+
+namespace fast_market {
+
+// Currently all critical path functions are inlined
+
+} // namespace fast_market
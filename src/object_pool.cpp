@@ -0,0 +1,10 @@
+// Implementation file for the object pool
+// All functionality is template-based and inline in the header
+
+#include "object_pool.hpp"
+
+namespace fast_market {
+
+// Template implementations are in the header
+
+} // namespace fast_market
@@ -0,0 +1,31 @@
+// Implementation file for the order book
+// Updates are inline in the header; construction and teardown live here
+
+#include "order_book.hpp"
+
+namespace fast_market {
+
+BookManager::BookManager(size_t expected_orders)
+    : orders_(expected_orders)
+    , order_pool_(expected_orders)
+    , level_pool_(std::make_unique<ObjectPool<PriceLevel>>())
+    , books_(MAX_LOCATES)
+{
+}
+
+BookManager::~BookManager() = default;
+
+void BookManager::clear() {
+    // Pooled orders and levels are released wholesale with their pools
+    orders_.clear();
+    for (auto& book : books_) {
+        book.reset();
+    }
+    symbols_.clear();
+    order_pool_.clear();
+    if (level_pool_ != nullptr) {
+        level_pool_->clear();
+    }
+}
+
+} // namespace fast_market
@@ -0,0 +1,104 @@
+// Implementation file for the parallel file parser
+// Mapping and boundary resync live here; the parse loop is inline
+
+#include "parallel_file_parser.hpp"
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fast_market {
+
+namespace {
+
+size_t resolve_threads(size_t threads) noexcept {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    return threads ? threads : 1;
+}
+
+} // namespace
+
+ParallelFileParser::ParallelFileParser(const std::string& path, size_t threads)
+    : threads_(resolve_threads(threads))
+{
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw std::runtime_error("Failed to stat file: " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    
+    if (size_ > 0) {
+        void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Failed to mmap file: " + path);
+        }
+        madvise(mapped, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const uint8_t*>(mapped);
+        mapped_ = true;
+    }
+    close(fd);
+}
+
+ParallelFileParser::ParallelFileParser(const uint8_t* data, size_t size, size_t threads)
+    : data_(data)
+    , size_(size)
+    , threads_(resolve_threads(threads))
+{
+}
+
+ParallelFileParser::~ParallelFileParser() {
+    if (mapped_) {
+        munmap(const_cast<uint8_t*>(data_), size_);
+    }
+}
+
+size_t ParallelFileParser::find_boundary(const uint8_t* data, size_t size, size_t from) noexcept {
+    constexpr size_t PREFIX = ITCHParser::FRAME_PREFIX_SIZE;
+    
+    for (size_t candidate = from; candidate + PREFIX < size; ++candidate) {
+        size_t offset = candidate;
+        size_t chain = 0;
+        while (chain < RESYNC_CHAIN && offset + PREFIX < size) {
+            const size_t length = ITCHParser::read_frame_length(data + offset);
+            if (length == 0 || MESSAGE_LENGTHS[data[offset + PREFIX]] != length ||
+                offset + PREFIX + length > size) {
+                break;
+            }
+            offset += PREFIX + length;
+            ++chain;
+        }
+        if (chain == RESYNC_CHAIN || (chain > 0 && offset == size)) {
+            return candidate;
+        }
+    }
+    return size;
+}
+
+std::vector<size_t> ParallelFileParser::plan_chunks(size_t count) const {
+    std::vector<size_t> cuts{0};
+    count = std::max<size_t>(count, 1);
+    
+    for (size_t i = 1; i < count; ++i) {
+        const size_t target = std::max(size_ / count * i, cuts.back());
+        const size_t boundary = find_boundary(data_, size_, target);
+        if (boundary > cuts.back() && boundary < size_) {
+            cuts.push_back(boundary);
+        }
+    }
+    if (size_ > 0) {
+        cuts.push_back(size_);
+    }
+    return cuts;
+}
+
+} // namespace fast_market
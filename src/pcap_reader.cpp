@@ -0,0 +1,324 @@
+// Implementation file for the pcap / pcapng reader
+// Record walking and header decoding; the replay loop is inline
+
+#include "pcap_reader.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fast_market {
+
+namespace {
+
+constexpr uint32_t PCAP_MAGIC_US = 0xA1B2C3D4;
+constexpr uint32_t PCAP_MAGIC_NS = 0xA1B23C4D;
+constexpr uint32_t PCAPNG_SECTION_HEADER = 0x0A0D0D0A;
+constexpr uint32_t PCAPNG_BYTE_ORDER_MAGIC = 0x1A2B3C4D;
+
+constexpr uint32_t PCAPNG_INTERFACE_DESCRIPTION = 1;
+constexpr uint32_t PCAPNG_SIMPLE_PACKET = 3;
+constexpr uint32_t PCAPNG_ENHANCED_PACKET = 6;
+constexpr uint16_t PCAPNG_OPTION_TSRESOL = 9;
+
+constexpr size_t PCAP_GLOBAL_HEADER_SIZE = 24;
+constexpr size_t PCAP_RECORD_HEADER_SIZE = 16;
+
+constexpr uint16_t LINKTYPE_ETHERNET = 1;
+constexpr uint16_t LINKTYPE_RAW = 101;
+constexpr uint16_t LINKTYPE_LINUX_SLL = 113;
+constexpr uint16_t LINKTYPE_IPV4 = 228;
+constexpr uint16_t LINKTYPE_IPV6 = 229;
+constexpr uint16_t LINKTYPE_LINUX_SLL2 = 276;
+
+constexpr uint16_t ETHERTYPE_IPV4 = 0x0800;
+constexpr uint16_t ETHERTYPE_IPV6 = 0x86DD;
+constexpr uint16_t ETHERTYPE_VLAN = 0x8100;
+constexpr uint16_t ETHERTYPE_QINQ = 0x88A8;
+
+constexpr uint8_t IPPROTO_UDP_NUMBER = 17;
+constexpr size_t UDP_HEADER_SIZE = 8;
+
+constexpr uint64_t NANOS_PER_SECOND = 1000000000ULL;
+
+// Network headers are big-endian regardless of the capture byte order
+uint16_t be16(const uint8_t* p) noexcept {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+uint32_t be32(const uint8_t* p) noexcept {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16)
+         | (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+uint32_t load32(const uint8_t* p) noexcept {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+uint64_t ticks_to_ns(uint64_t ticks, uint64_t ticks_per_second) noexcept {
+    if (ticks_per_second == NANOS_PER_SECOND) {
+        return ticks;
+    }
+    return (ticks / ticks_per_second) * NANOS_PER_SECOND
+         + (ticks % ticks_per_second) * NANOS_PER_SECOND / ticks_per_second;
+}
+
+} // namespace
+
+PcapReader::PcapReader(const std::string& path) {
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open capture: " + path);
+    }
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(PCAP_GLOBAL_HEADER_SIZE)) {
+        close(fd);
+        throw std::runtime_error("Capture too short: " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    
+    void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Failed to mmap capture: " + path);
+    }
+    data_ = static_cast<const uint8_t*>(mapped);
+    madvise(mapped, size_, MADV_SEQUENTIAL);
+    
+    const uint32_t magic = load32(data_);
+    if (magic == PCAP_MAGIC_US || magic == __builtin_bswap32(PCAP_MAGIC_US) ||
+        magic == PCAP_MAGIC_NS || magic == __builtin_bswap32(PCAP_MAGIC_NS)) {
+        format_ = Format::PCAP;
+        swapped_ = (magic == __builtin_bswap32(PCAP_MAGIC_US) || magic == __builtin_bswap32(PCAP_MAGIC_NS));
+        ts_fraction_ns_ = (read32(data_) == PCAP_MAGIC_NS) ? 1 : 1000;
+        link_type_ = static_cast<uint16_t>(read32(data_ + 20));
+        first_record_ = PCAP_GLOBAL_HEADER_SIZE;
+    } else if (magic == PCAPNG_SECTION_HEADER) {
+        // The section header block is parsed as part of the block walk
+        format_ = Format::PCAPNG;
+        first_record_ = 0;
+    } else {
+        munmap(mapped, size_);
+        throw std::runtime_error("Not a pcap or pcapng file: " + path);
+    }
+    
+    offset_ = first_record_;
+}
+
+PcapReader::~PcapReader() {
+    if (data_) {
+        munmap(const_cast<uint8_t*>(data_), size_);
+    }
+}
+
+void PcapReader::rewind() noexcept {
+    offset_ = first_record_;
+    interface_count_ = 0;
+}
+
+uint16_t PcapReader::read16(const uint8_t* p) const noexcept {
+    uint16_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return swapped_ ? __builtin_bswap16(v) : v;
+}
+
+uint32_t PcapReader::read32(const uint8_t* p) const noexcept {
+    const uint32_t v = load32(p);
+    return swapped_ ? __builtin_bswap32(v) : v;
+}
+
+bool PcapReader::next(CapturedPacket& packet) noexcept {
+    Frame frame;
+    for (;;) {
+        const bool found = (format_ == Format::PCAP) ? next_pcap_frame(frame) : next_pcapng_frame(frame);
+        if (!found) {
+            return false;
+        }
+        if (extract_udp(frame, packet) && (port_filter_ == 0 || packet.dst_port == port_filter_)) {
+            return true;
+        }
+        ++records_skipped_;
+    }
+}
+
+bool PcapReader::next_pcap_frame(Frame& frame) noexcept {
+    if (offset_ + PCAP_RECORD_HEADER_SIZE > size_) {
+        return false;
+    }
+    
+    const uint8_t* record = data_ + offset_;
+    const uint32_t captured = read32(record + 8);
+    if (captured > size_ - offset_ - PCAP_RECORD_HEADER_SIZE) {
+        offset_ = size_;  // Truncated final record
+        return false;
+    }
+    
+    frame.data = record + PCAP_RECORD_HEADER_SIZE;
+    frame.length = captured;
+    frame.timestamp_ns = static_cast<uint64_t>(read32(record)) * NANOS_PER_SECOND
+                       + static_cast<uint64_t>(read32(record + 4)) * ts_fraction_ns_;
+    frame.link_type = link_type_;
+    offset_ += PCAP_RECORD_HEADER_SIZE + captured;
+    return true;
+}
+
+bool PcapReader::next_pcapng_frame(Frame& frame) noexcept {
+    while (offset_ + 12 <= size_) {
+        const uint8_t* block = data_ + offset_;
+        
+        if (load32(block) == PCAPNG_SECTION_HEADER) {
+            // New section: byte order and interfaces start over
+            const uint32_t order = load32(block + 8);
+            if (order != PCAPNG_BYTE_ORDER_MAGIC && order != __builtin_bswap32(PCAPNG_BYTE_ORDER_MAGIC)) {
+                offset_ = size_;
+                return false;
+            }
+            swapped_ = (order != PCAPNG_BYTE_ORDER_MAGIC);
+            interface_count_ = 0;
+        }
+        
+        const uint32_t type = read32(block);
+        const uint32_t block_len = read32(block + 4);
+        if (block_len < 12 || block_len > size_ - offset_) {
+            offset_ = size_;  // Corrupt or truncated block
+            return false;
+        }
+        offset_ += block_len;
+        
+        const uint8_t* body = block + 8;
+        const size_t body_len = block_len - 12;
+        
+        if (type == PCAPNG_INTERFACE_DESCRIPTION && body_len >= 8) {
+            if (interface_count_ >= MAX_INTERFACES) {
+                continue;
+            }
+            uint64_t ticks_per_second = 1000000;  // Default resolution is microseconds
+            
+            size_t opt = 8;
+            while (opt + 4 <= body_len) {
+                const uint16_t code = read16(body + opt);
+                const uint16_t len = read16(body + opt + 2);
+                if (code == 0 || opt + 4 + len > body_len) {
+                    break;
+                }
+                if (code == PCAPNG_OPTION_TSRESOL && len >= 1) {
+                    const uint8_t resol = body[opt + 4];
+                    const uint8_t exponent = resol & 0x7F;
+                    if (exponent <= ((resol & 0x80) ? 63 : 19)) {  // Fits in 64 bits
+                        ticks_per_second = 1;
+                        for (uint8_t i = 0; i < exponent; ++i) {
+                            ticks_per_second *= (resol & 0x80) ? 2 : 10;
+                        }
+                    }
+                }
+                opt += 4 + ((len + 3u) & ~3u);
+            }
+            
+            if_link_type_[interface_count_] = read16(body);
+            if_ticks_per_second_[interface_count_] = ticks_per_second;
+            ++interface_count_;
+        } else if (type == PCAPNG_ENHANCED_PACKET && body_len >= 20) {
+            const uint32_t interface = read32(body);
+            const uint32_t captured = read32(body + 12);
+            if (interface >= interface_count_ || captured > body_len - 20) {
+                ++records_skipped_;
+                continue;
+            }
+            const uint64_t ticks = (static_cast<uint64_t>(read32(body + 4)) << 32) | read32(body + 8);
+            frame.data = body + 20;
+            frame.length = captured;
+            frame.timestamp_ns = ticks_to_ns(ticks, if_ticks_per_second_[interface]);
+            frame.link_type = if_link_type_[interface];
+            return true;
+        } else if (type == PCAPNG_SIMPLE_PACKET && body_len >= 4 && interface_count_ > 0) {
+            const uint32_t original = read32(body);
+            frame.data = body + 4;
+            frame.length = std::min<size_t>(original, body_len - 4);
+            frame.timestamp_ns = 0;  // Simple packet blocks carry no timestamp
+            frame.link_type = if_link_type_[0];
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PcapReader::extract_udp(const Frame& frame, CapturedPacket& packet) const noexcept {
+    const uint8_t* p = frame.data;
+    size_t len = frame.length;
+    uint16_t ethertype = 0;
+    
+    switch (frame.link_type) {
+        case LINKTYPE_ETHERNET:
+            if (len < 14) return false;
+            ethertype = be16(p + 12);
+            p += 14;
+            len -= 14;
+            while ((ethertype == ETHERTYPE_VLAN || ethertype == ETHERTYPE_QINQ) && len >= 4) {
+                ethertype = be16(p + 2);
+                p += 4;
+                len -= 4;
+            }
+            break;
+        case LINKTYPE_LINUX_SLL:
+            if (len < 16) return false;
+            ethertype = be16(p + 14);
+            p += 16;
+            len -= 16;
+            break;
+        case LINKTYPE_LINUX_SLL2:
+            if (len < 20) return false;
+            ethertype = be16(p);
+            p += 20;
+            len -= 20;
+            break;
+        case LINKTYPE_RAW:
+        case LINKTYPE_IPV4:
+        case LINKTYPE_IPV6:
+            if (len < 1) return false;
+            ethertype = ((p[0] >> 4) == 6) ? ETHERTYPE_IPV6 : ETHERTYPE_IPV4;
+            break;
+        default:
+            return false;
+    }
+    
+    if (ethertype == ETHERTYPE_IPV4) {
+        if (len < 20 || (p[0] >> 4) != 4) return false;
+        const size_t header_len = static_cast<size_t>(p[0] & 0x0F) * 4;
+        const size_t total_len = be16(p + 2);
+        const uint16_t fragment = be16(p + 6);
+        if (header_len < 20 || total_len < header_len || total_len > len) return false;
+        if ((fragment & 0x3FFF) != 0) return false;  // More-fragments flag or non-zero offset
+        if (p[9] != IPPROTO_UDP_NUMBER) return false;
+        packet.dst_ipv4 = be32(p + 16);
+        len = total_len - header_len;  // Drops Ethernet trailer padding
+        p += header_len;
+    } else if (ethertype == ETHERTYPE_IPV6) {
+        if (len < 40 || (p[0] >> 4) != 6) return false;
+        const size_t payload_len = be16(p + 4);
+        if (p[6] != IPPROTO_UDP_NUMBER || payload_len > len - 40) return false;
+        packet.dst_ipv4 = 0;
+        len = payload_len;
+        p += 40;
+    } else {
+        return false;
+    }
+    
+    if (len < UDP_HEADER_SIZE) return false;
+    const size_t udp_len = be16(p + 4);
+    if (udp_len < UDP_HEADER_SIZE || udp_len > len) return false;
+    
+    packet.src_port = be16(p);
+    packet.dst_port = be16(p + 2);
+    packet.payload = p + UDP_HEADER_SIZE;
+    packet.length = udp_len - UDP_HEADER_SIZE;
+    packet.timestamp_ns = frame.timestamp_ns;
+    return true;
+}
+
+} // namespace fast_market
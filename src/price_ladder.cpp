@@ -0,0 +1,10 @@
+// Implementation file for the price ladder
+// All functionality is template-based and inline in the header
+
+#include "price_ladder.hpp"
+
+namespace fast_market {
+
+// Template implementations are in the header
+
+} // namespace fast_market
@@ -0,0 +1,10 @@
+// Implementation file for the symbol-sharded pipeline
+// All functionality is template-based and inline in the header
+
+#include "sharded_pipeline.hpp"
+
+namespace fast_market {
+
+// Template implementations are in the header
+
+} // namespace fast_market
@@ -0,0 +1,206 @@
+// Implementation file for the SoupBinTCP session
+// Packet framing is inline in the header; socket setup, control packets
+// and heartbeats live here
+
+#include "soupbintcp.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace fast_market {
+
+namespace {
+
+uint64_t monotonic_ns() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Alpha fields are left-justified, numeric fields right-justified, both
+// padded with spaces
+void put_alpha(char* dest, size_t width, std::string_view value) noexcept {
+    std::memset(dest, ' ', width);
+    std::memcpy(dest, value.data(), std::min(value.size(), width));
+}
+
+void put_numeric(char* dest, size_t width, uint64_t value) noexcept {
+    std::memset(dest, ' ', width);
+    size_t pos = width;
+    do {
+        dest[--pos] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0 && pos > 0);
+}
+
+uint64_t get_numeric(const uint8_t* src, size_t width) noexcept {
+    uint64_t value = 0;
+    for (size_t i = 0; i < width; ++i) {
+        if (src[i] >= '0' && src[i] <= '9') {
+            value = value * 10 + (src[i] - '0');
+        }
+    }
+    return value;
+}
+
+} // namespace
+
+SoupBinTCPSession::SoupBinTCPSession(size_t ring_size)
+    : ring_(std::max(ring_size, MIN_RING_SIZE))
+{
+}
+
+SoupBinTCPSession::~SoupBinTCPSession() {
+    close_socket();
+}
+
+void SoupBinTCPSession::connect(const std::string& host, uint16_t port) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    
+    addrinfo* addresses = nullptr;
+    const std::string service = std::to_string(port);
+    if (getaddrinfo(host.c_str(), service.c_str(), &hints, &addresses) != 0) {
+        throw std::runtime_error("Failed to resolve " + host);
+    }
+    
+    int fd = -1;
+    for (addrinfo* ai = addresses; ai != nullptr; ai = ai->ai_next) {
+        fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+            break;
+        }
+        ::close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(addresses);
+    
+    if (fd < 0) {
+        throw std::runtime_error("Failed to connect to " + host + ":" + service);
+    }
+    attach(fd);
+}
+
+void SoupBinTCPSession::attach(int fd) {
+    close_socket();
+    
+    const int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to make socket non-blocking");
+    }
+    const int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    
+    fd_ = fd;
+    ring_.clear();
+    state_ = State::DISCONNECTED;
+}
+
+void SoupBinTCPSession::login(std::string_view username, std::string_view password,
+                              std::string_view session, uint64_t sequence) {
+    char payload[46];
+    put_alpha(payload, 6, username);
+    put_alpha(payload + 6, 10, password);
+    put_alpha(payload + 16, 10, session);
+    put_numeric(payload + 26, 20, sequence);
+    
+    if (!send_packet(SoupPacketType::LOGIN_REQUEST, payload, sizeof(payload))) {
+        throw std::runtime_error("Failed to send SoupBinTCP login request");
+    }
+    state_ = State::LOGIN_PENDING;
+}
+
+void SoupBinTCPSession::logout() noexcept {
+    send_packet(SoupPacketType::LOGOUT_REQUEST, nullptr, 0);
+}
+
+void SoupBinTCPSession::receive() noexcept {
+    const size_t space = ring_.writable();
+    if (space == 0) [[unlikely]] {
+        return;  // Caller is behind; packets are framed before the next read
+    }
+    
+    const ssize_t n = ::recv(fd_, ring_.write_ptr(), space, 0);
+    if (n > 0) [[likely]] {
+        ring_.commit(static_cast<size_t>(n));
+    } else if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        // Already-buffered packets are still framed by this poll
+        close_socket();
+        if (state_ != State::ENDED && state_ != State::REJECTED) {
+            state_ = State::DISCONNECTED;
+        }
+    }
+}
+
+void SoupBinTCPSession::handle_control(SoupPacketType type, const uint8_t* payload, size_t length) noexcept {
+    switch (type) {
+        case SoupPacketType::LOGIN_ACCEPTED:
+            if (length >= 30) {
+                std::memcpy(session_.data(), payload, session_.size());
+                next_sequence_ = get_numeric(payload + 10, 20);
+                state_ = State::ACTIVE;
+            }
+            break;
+        case SoupPacketType::LOGIN_REJECTED:
+            reject_reason_ = length > 0 ? static_cast<char>(payload[0]) : ' ';
+            state_ = State::REJECTED;
+            break;
+        case SoupPacketType::END_OF_SESSION:
+            state_ = State::ENDED;
+            break;
+        default:
+            // Server heartbeats and debug packets need no action
+            break;
+    }
+}
+
+void SoupBinTCPSession::service_heartbeat() noexcept {
+    const uint64_t now = monotonic_ns();
+    if (now - last_send_ns_ >= HEARTBEAT_INTERVAL_NS) {
+        send_packet(SoupPacketType::CLIENT_HEARTBEAT, nullptr, 0);
+    }
+}
+
+bool SoupBinTCPSession::send_packet(SoupPacketType type, const char* payload, size_t length) noexcept {
+    // Client packets are small and fixed-size
+    char packet[PACKET_PREFIX_SIZE + 1 + 64];
+    if (fd_ < 0 || length > sizeof(packet) - PACKET_PREFIX_SIZE - 1) {
+        return false;
+    }
+    
+    const uint16_t packet_len = htons(static_cast<uint16_t>(length + 1));
+    std::memcpy(packet, &packet_len, sizeof(packet_len));
+    packet[PACKET_PREFIX_SIZE] = static_cast<char>(type);
+    if (length > 0) {
+        std::memcpy(packet + PACKET_PREFIX_SIZE + 1, payload, length);
+    }
+    
+    const size_t total = PACKET_PREFIX_SIZE + 1 + length;
+    if (::send(fd_, packet, total, MSG_NOSIGNAL) != static_cast<ssize_t>(total)) {
+        return false;
+    }
+    last_send_ns_ = monotonic_ns();
+    return true;
+}
+
+void SoupBinTCPSession::close_socket() noexcept {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+} // namespace fast_market
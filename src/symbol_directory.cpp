@@ -0,0 +1,71 @@
+// Implementation file for the symbol directory
+// Lookups are inline in the header; directory updates live here
+
+#include "symbol_directory.hpp"
+#include <algorithm>
+
+namespace fast_market {
+
+namespace {
+
+// Room for a full NASDAQ listing without the reverse map growing
+constexpr size_t EXPECTED_SYMBOLS = 16384;
+
+} // namespace
+
+SymbolDirectory::SymbolDirectory()
+    : entries_(MAX_LOCATES)
+    , by_symbol_(EXPECTED_SYMBOLS)
+{
+}
+
+void SymbolDirectory::on_stock_directory(const StockDirectoryView& msg) {
+    SymbolInfo info;
+    info.stock = msg.stock();
+    info.round_lot_size = msg.round_lot_size();
+    info.etp_leverage_factor = msg.etp_leverage_factor();
+    info.market_category = msg.market_category();
+    info.financial_status_indicator = msg.financial_status_indicator();
+    info.round_lots_only = msg.round_lots_only();
+    info.issue_classification = msg.issue_classification();
+    info.issue_sub_type = msg.issue_sub_type();
+    info.authenticity = msg.authenticity();
+    info.short_sale_threshold_indicator = msg.short_sale_threshold_indicator();
+    info.ipo_flag = msg.ipo_flag();
+    info.luld_reference_price_tier = msg.luld_reference_price_tier();
+    info.etp_flag = msg.etp_flag();
+    info.inverse_indicator = msg.inverse_indicator();
+    add(msg.stock_locate(), info);
+}
+
+void SymbolDirectory::add(uint16_t stock_locate, const SymbolInfo& info) {
+    const uint8_t length = static_cast<uint8_t>(get_stock_symbol(info.stock).size());
+    if (length == 0) {
+        return;
+    }
+    
+    // Re-listing a locate under a new symbol drops its old reverse entry
+    SymbolInfo& entry = entries_[stock_locate];
+    if (entry.symbol_length != 0 && entry.stock != info.stock) {
+        by_symbol_.erase(symbol_key(entry.stock));
+    }
+    entry = info;
+    entry.symbol_length = length;
+    
+    const uint64_t key = symbol_key(info.stock);
+    if (uint16_t* existing = by_symbol_.find(key)) {
+        if (*existing != stock_locate) {
+            entries_[*existing] = SymbolInfo{};  // The symbol moved
+            *existing = stock_locate;
+        }
+    } else {
+        by_symbol_.insert(key, stock_locate);
+    }
+}
+
+void SymbolDirectory::clear() {
+    std::fill(entries_.begin(), entries_.end(), SymbolInfo{});
+    by_symbol_.clear();
+}
+
+} // namespace fast_market
@@ -0,0 +1,64 @@
+// Implementation file for the symbol filter
+// The per-message check is inline in the header; subscription bookkeeping
+// lives here
+
+#include "symbol_filter.hpp"
+#include <bit>
+
+namespace fast_market {
+
+SymbolFilter::SymbolFilter() noexcept {
+    for (auto& w : bitmap_) {
+        w.store(0, std::memory_order_relaxed);
+    }
+    for (auto& w : pinned_) {
+        w.store(0, std::memory_order_relaxed);
+    }
+    enable(0);
+}
+
+void SymbolFilter::subscribe(std::string_view symbol) {
+    const uint64_t key = symbol_key(symbol);
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscribed_.insert(key);
+    if (auto it = locates_.find(key); it != locates_.end()) {
+        enable(it->second);
+    }
+}
+
+void SymbolFilter::unsubscribe(std::string_view symbol) {
+    const uint64_t key = symbol_key(symbol);
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscribed_.erase(key);
+    if (auto it = locates_.find(key); it != locates_.end()) {
+        release(it->second);
+    }
+}
+
+void SymbolFilter::learn(uint16_t stock_locate, const std::array<char, 8>& stock) {
+    const uint64_t key = symbol_key(stock);
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    // A symbol moved to a new locate releases the old one
+    auto [it, inserted] = locates_.try_emplace(key, stock_locate);
+    if (!inserted && it->second != stock_locate) {
+        release(it->second);
+        it->second = stock_locate;
+    }
+    
+    if (subscribed_.count(key)) {
+        enable(stock_locate);
+    } else {
+        release(stock_locate);
+    }
+}
+
+size_t SymbolFilter::accepted_count() const noexcept {
+    size_t count = 0;
+    for (const auto& w : bitmap_) {
+        count += std::popcount(w.load(std::memory_order_relaxed));
+    }
+    return count;
+}
+
+} // namespace fast_market
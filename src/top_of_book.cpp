@@ -0,0 +1,32 @@
+// Implementation file for the top-of-book table
+// Publishing and reading are inline in the header; the mapping lives here
+
+#include "top_of_book.hpp"
+#include <new>
+
+namespace fast_market {
+
+TopOfBookTable::TopOfBookTable() {
+    void* memory = SystemUtils::allocate_large(MAX_LOCATES * sizeof(Entry));
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    entries_ = new (memory) Entry[MAX_LOCATES];
+}
+
+TopOfBookTable::~TopOfBookTable() {
+    SystemUtils::free_large(entries_, MAX_LOCATES * sizeof(Entry));
+}
+
+void TopOfBookTable::clear() noexcept {
+    for (size_t i = 0; i < MAX_LOCATES; ++i) {
+        Entry& entry = entries_[i];
+        entry.sequence.store(0, std::memory_order_relaxed);
+        entry.prices.store(0, std::memory_order_relaxed);
+        entry.bid_shares.store(0, std::memory_order_relaxed);
+        entry.ask_shares.store(0, std::memory_order_relaxed);
+        entry.timestamp.store(0, std::memory_order_relaxed);
+    }
+}
+
+} // namespace fast_market
@@ -1,12 +1,41 @@
 #include "itch_parser.hpp"
+#include "header_decoder.hpp"
+#include "moldudp64.hpp"
+#include "soupbintcp.hpp"
+#include "pcap_reader.hpp"
+#include "parallel_file_parser.hpp"
+#include "gzip_stream.hpp"
+#include "sharded_pipeline.hpp"
+#include "symbol_directory.hpp"
+#include "order_book.hpp"
+#include "flat_order_map.hpp"
+#include "object_pool.hpp"
+#include "price_ladder.hpp"
+#include "top_of_book.hpp"
+#include "book_checkpoint.hpp"
+#include "bar_aggregator.hpp"
 #include "async_logger.hpp"
+#include "log_index.hpp"
 #include "mpmc_queue.hpp"
 #include "system_utils.hpp"
+#include <atomic>
+#include <deque>
 #include <iostream>
+#include <map>
+#include <random>
+#include <unordered_map>
 #include <cassert>
 #include <cstring>
 #include <thread>
 #include <vector>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <zlib.h>
 
 using namespace fast_market;
 
@@ -105,7 +134,7 @@ TEST(parser_add_order) {
     order->header.message_type = static_cast<uint8_t>(MessageType::ADD_ORDER);
     order->header.stock_locate = hton16(123);
     order->header.tracking_number = hton16(456);
-    order->header.timestamp = hton64(1234567890ULL);
+    order->header.timestamp = hton48(1234567890ULL);
     order->order_reference_number = hton64(999999ULL);
     order->buy_sell_indicator = 'B';
     order->shares = hton32(100);
@@ -119,7 +148,7 @@ TEST(parser_add_order) {
     assert(parsed->type == MessageType::ADD_ORDER);
     assert(parsed->add_order.header.stock_locate == 123);
     assert(parsed->add_order.header.tracking_number == 456);
-    assert(parsed->add_order.header.timestamp == 1234567890ULL);
+    assert(parsed->add_order.header.timestamp.value() == 1234567890ULL);
     assert(parsed->add_order.order_reference_number == 999999ULL);
     assert(parsed->add_order.buy_sell_indicator == 'B');
     assert(parsed->add_order.shares == 100);
@@ -139,7 +168,7 @@ TEST(parser_execute_order) {
     exec->header.message_type = static_cast<uint8_t>(MessageType::EXECUTE_ORDER);
     exec->header.stock_locate = hton16(1);
     exec->header.tracking_number = hton16(2);
-    exec->header.timestamp = hton64(9876543210ULL);
+    exec->header.timestamp = hton48(9876543210ULL);
     exec->order_reference_number = hton64(111111ULL);
     exec->executed_shares = hton32(50);
     exec->match_number = hton64(222222ULL);
@@ -175,6 +204,1446 @@ TEST(parser_invalid_message) {
     assert(!result.has_value());
 }
 
+// Append a message to a buffer with its 2-byte big-endian length prefix
+void append_frame(std::vector<uint8_t>& buffer, const std::vector<uint8_t>& msg) {
+    uint16_t len = hton16(static_cast<uint16_t>(msg.size()));
+    const auto* prefix = reinterpret_cast<const uint8_t*>(&len);
+    buffer.insert(buffer.end(), prefix, prefix + 2);
+    buffer.insert(buffer.end(), msg.begin(), msg.end());
+}
+
+std::vector<uint8_t> make_add_order(uint64_t ref, uint16_t locate = 1) {
+    std::vector<uint8_t> msg(sizeof(AddOrderMessage));
+    auto* order = reinterpret_cast<AddOrderMessage*>(msg.data());
+    order->header.message_type = static_cast<uint8_t>(MessageType::ADD_ORDER);
+    order->header.stock_locate = hton16(locate);
+    order->header.timestamp = hton48(ref);
+    order->order_reference_number = hton64(ref);
+    order->buy_sell_indicator = 'B';
+    order->shares = hton32(100);
+    std::memcpy(order->stock.data(), "AAPL    ", 8);
+    order->price = hton32(1500000);
+    return msg;
+}
+
+std::vector<uint8_t> make_order_delete(uint64_t ref, uint16_t locate = 1) {
+    std::vector<uint8_t> msg(sizeof(OrderDeleteMessage));
+    auto* del = reinterpret_cast<OrderDeleteMessage*>(msg.data());
+    del->header.message_type = static_cast<uint8_t>(MessageType::ORDER_DELETE);
+    del->header.stock_locate = hton16(locate);
+    del->header.timestamp = hton48(ref);
+    del->order_reference_number = hton64(ref);
+    return msg;
+}
+
+TEST(parser_batch_framing) {
+    std::vector<uint8_t> buffer;
+    append_frame(buffer, make_add_order(1));
+    append_frame(buffer, make_order_delete(1));
+    append_frame(buffer, std::vector<uint8_t>(7, 'Z'));  // Unknown type, skipped
+    append_frame(buffer, make_add_order(2));
+    
+    // Drop the last byte so the final frame is incomplete
+    ITCHParser parser;
+    std::vector<uint64_t> refs;
+    auto result = parser.parse_batch(buffer.data(), buffer.size() - 1, [&](const ParsedMessage& msg) {
+        refs.push_back(msg.type == MessageType::ADD_ORDER
+            ? msg.add_order.order_reference_number
+            : msg.order_delete.order_reference_number);
+    });
+    
+    assert(result.messages_parsed == 2);
+    assert(result.messages_skipped == 1);
+    assert(result.bytes_consumed == buffer.size() - (2 + sizeof(AddOrderMessage)));
+    assert(refs.size() == 2 && refs[0] == 1 && refs[1] == 1);
+}
+
+TEST(parser_stream_split_frames) {
+    std::vector<uint8_t> buffer;
+    for (uint64_t i = 0; i < 4; ++i) {
+        append_frame(buffer, make_add_order(i));
+        append_frame(buffer, make_order_delete(i));
+    }
+    
+    // Split the stream at every possible point, including inside the prefix
+    for (size_t split = 0; split <= buffer.size(); ++split) {
+        ITCHParser parser;
+        std::vector<MessageType> types;
+        auto handler = [&](const ParsedMessage& msg) { types.push_back(msg.type); };
+        
+        auto first = parser.parse_stream(buffer.data(), split, handler);
+        auto second = parser.parse_stream(buffer.data() + split, buffer.size() - split, handler);
+        
+        assert(first.bytes_consumed == split);
+        assert(first.messages_parsed + second.messages_parsed == 8);
+        assert(parser.pending_bytes() == 0);
+        assert(types.size() == 8);
+        assert(types[0] == MessageType::ADD_ORDER && types[7] == MessageType::ORDER_DELETE);
+    }
+    
+    // Byte-at-a-time delivery
+    ITCHParser parser;
+    size_t count = 0;
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        count += parser.parse_stream(&buffer[i], 1, [](const ParsedMessage&) {}).messages_parsed;
+    }
+    assert(count == 8);
+}
+
+// Handler that only subscribes to a subset of message types
+struct CountingHandler {
+    uint64_t last_add_ref = 0;
+    uint32_t last_add_shares = 0;
+    uint64_t last_delete_ref = 0;
+    int adds = 0;
+    int deletes = 0;
+    
+    void on_add_order(const AddOrderView& msg) {
+        last_add_ref = msg.order_reference_number();
+        last_add_shares = msg.shares();
+        ++adds;
+    }
+    
+    void on_order_delete(const OrderDeleteView& msg) {
+        last_delete_ref = msg.order_reference_number();
+        ++deletes;
+    }
+};
+
+TEST(parser_handler_dispatch) {
+    ITCHParser parser;
+    CountingHandler handler;
+    
+    auto add = make_add_order(42);
+    assert(parser.parse(add.data(), add.size(), handler));
+    assert(handler.adds == 1);
+    assert(handler.last_add_ref == 42);
+    assert(handler.last_add_shares == 100);
+    
+    // Valid message without a callback is accepted but not delivered
+    std::vector<uint8_t> exec(sizeof(ExecuteOrderMessage));
+    exec[0] = static_cast<uint8_t>(MessageType::EXECUTE_ORDER);
+    assert(parser.parse(exec.data(), exec.size(), handler));
+    
+    // Wrong length is rejected
+    assert(!parser.parse(add.data(), add.size() - 1, handler));
+    assert(handler.adds == 1);
+    
+    // Framed input routes to the same callbacks
+    std::vector<uint8_t> buffer;
+    append_frame(buffer, make_add_order(7));
+    append_frame(buffer, make_order_delete(7));
+    auto result = parser.parse_batch(buffer.data(), buffer.size(), handler);
+    assert(result.messages_parsed == 2);
+    assert(handler.adds == 2 && handler.deletes == 1);
+    assert(handler.last_delete_ref == 7);
+}
+
+TEST(parser_all_message_types) {
+    // Every ITCH 5.0 type byte with its spec length
+    const std::pair<char, size_t> spec[] = {
+        {'S', 12}, {'R', 39}, {'H', 25}, {'Y', 20}, {'L', 26}, {'V', 35},
+        {'W', 12}, {'K', 28}, {'J', 35}, {'h', 21}, {'A', 36}, {'F', 40},
+        {'E', 31}, {'C', 36}, {'X', 23}, {'D', 19}, {'U', 35}, {'P', 44},
+        {'Q', 40}, {'B', 19}, {'I', 50}, {'N', 20}, {'O', 48},
+    };
+    
+    ITCHParser parser;
+    size_t known = 0;
+    for (const auto& [type, length] : spec) {
+        assert(MESSAGE_LENGTHS[static_cast<uint8_t>(type)] == length);
+        
+        std::vector<uint8_t> msg(length);
+        auto* header = reinterpret_cast<ITCHMessageHeader*>(msg.data());
+        header->message_type = static_cast<uint8_t>(type);
+        header->stock_locate = hton16(77);
+        
+        auto parsed = parser.parse(msg.data(), msg.size());
+        assert(parsed.has_value());
+        assert(static_cast<char>(parsed->type) == type);
+        assert(parsed->system_event.header.stock_locate == 77);
+        
+        assert(!parser.parse(msg.data(), msg.size() + 1).has_value());
+    }
+    
+    for (size_t i = 0; i < 256; ++i) {
+        known += MESSAGE_LENGTHS[i] != 0;
+    }
+    assert(known == std::size(spec));
+}
+
+TEST(parser_new_message_fields) {
+    std::vector<uint8_t> msg(sizeof(CrossTradeMessage));
+    auto* cross = reinterpret_cast<CrossTradeMessage*>(msg.data());
+    cross->header.message_type = static_cast<uint8_t>(MessageType::CROSS_TRADE);
+    cross->shares = hton64(5000000000ULL);
+    std::memcpy(cross->stock.data(), "SPY     ", 8);
+    cross->cross_price = hton32(4500000);
+    cross->match_number = hton64(31337);
+    cross->cross_type = 'O';
+    
+    ITCHParser parser;
+    auto parsed = parser.parse(msg.data(), msg.size());
+    assert(parsed.has_value());
+    assert(parsed->cross_trade.shares == 5000000000ULL);
+    assert(get_stock_symbol(parsed->cross_trade.stock) == "SPY");
+    assert(parsed->cross_trade.cross_price == 4500000);
+    assert(parsed->cross_trade.match_number == 31337);
+    
+    struct CrossHandler {
+        uint64_t match = 0;
+        void on_cross_trade(const CrossTradeView& m) { match = m.match_number(); }
+    } handler;
+    assert(parser.parse(msg.data(), msg.size(), handler));
+    assert(handler.match == 31337);
+}
+
+TEST(message_views) {
+    auto msg = make_add_order(123456789ULL, 42);
+    
+    // Views read straight from the wire bytes
+    AddOrderView view(msg.data());
+    assert(view.type() == MessageType::ADD_ORDER);
+    assert(view.stock_locate() == 42);
+    assert(view.timestamp() == 123456789ULL);
+    assert(view.order_reference_number() == 123456789ULL);
+    assert(view.shares() == 100);
+    assert(view.price() == 1500000);
+    assert(view.symbol() == "AAPL");
+    assert(view.data() == msg.data());
+    
+    // Materialized copy matches the eager parser
+    AddOrderMessage decoded = decode_message(view);
+    ITCHParser parser;
+    auto parsed = parser.parse(msg.data(), msg.size());
+    assert(std::memcmp(&decoded, &parsed->add_order, sizeof(AddOrderMessage)) == 0);
+    
+    // Header-only view works for any message type
+    auto del = make_order_delete(5, 9);
+    HeaderView header(del.data());
+    assert(header.type() == MessageType::ORDER_DELETE);
+    assert(header.stock_locate() == 9);
+    
+    // Admin messages use the generic view
+    std::vector<uint8_t> halt(sizeof(OperationalHaltMessage));
+    halt[0] = static_cast<uint8_t>(MessageType::OPERATIONAL_HALT);
+    struct HaltHandler {
+        uint8_t action = 0;
+        void on_operational_halt(const OperationalHaltView& v) {
+            action = decode_message(v).operational_halt_action;
+        }
+    } handler;
+    halt.back() = 'H';
+    assert(parser.parse(halt.data(), halt.size(), handler));
+    assert(handler.action == 'H');
+}
+
+TEST(batch_header_decoder) {
+    // Mixed sizes so headers land at irregular offsets; 37 is not a
+    // multiple of either vector width, so the tail path is exercised
+    std::vector<uint8_t> buffer;
+    for (uint64_t i = 0; i < 37; ++i) {
+        auto msg = (i % 3 == 0) ? make_order_delete(i, static_cast<uint16_t>(i * 7))
+                                : make_add_order(0xABCDEF000000ULL + i, static_cast<uint16_t>(i));
+        reinterpret_cast<ITCHMessageHeader*>(msg.data())->tracking_number = hton16(static_cast<uint16_t>(1000 + i));
+        append_frame(buffer, msg);
+    }
+    
+    std::vector<uint32_t> offsets(64);
+    size_t consumed = 0;
+    size_t count = ITCHParser::index_frames(buffer.data(), buffer.size(), offsets.data(), offsets.size(), consumed);
+    assert(count == 37);
+    assert(consumed == buffer.size());
+    
+    std::vector<SimdLevel> levels = {SimdLevel::SCALAR};
+    if (BatchHeaderDecoder::best_available() >= SimdLevel::AVX2) levels.push_back(SimdLevel::AVX2);
+    if (BatchHeaderDecoder::best_available() >= SimdLevel::AVX512) levels.push_back(SimdLevel::AVX512);
+    
+    for (SimdLevel level : levels) {
+        std::vector<uint8_t> types(count);
+        std::vector<uint16_t> locates(count), tracking(count);
+        std::vector<uint64_t> timestamps(count);
+        BatchHeaderDecoder::decode(level, buffer.data(), buffer.size(), offsets.data(), count,
+                                   HeaderColumns{types.data(), locates.data(), tracking.data(), timestamps.data()});
+        
+        for (size_t i = 0; i < count; ++i) {
+            HeaderView expected(buffer.data() + offsets[i]);
+            assert(types[i] == static_cast<uint8_t>(expected.type()));
+            assert(locates[i] == expected.stock_locate());
+            assert(tracking[i] == 1000 + i);
+            assert(timestamps[i] == expected.timestamp());
+        }
+    }
+}
+
+TEST(parser_subscription_mask) {
+    using OrderFlowParser = BasicITCHParser<MessageTypeSet<
+        MessageType::ADD_ORDER, MessageType::ORDER_DELETE>>;
+    static_assert(!OrderFlowParser::subscribes(MessageType::STOCK_DIRECTORY));
+    static_assert(ITCHParser::subscribes(MessageType::STOCK_DIRECTORY));
+    
+    OrderFlowParser parser;
+    std::vector<uint8_t> directory(sizeof(StockDirectoryMessage));
+    directory[0] = static_cast<uint8_t>(MessageType::STOCK_DIRECTORY);
+    assert(!parser.parse(directory.data(), directory.size()).has_value());
+    
+    auto add = make_add_order(5);
+    auto parsed = parser.parse(add.data(), add.size());
+    assert(parsed && parsed->add_order.order_reference_number == 5);
+    
+    // Unsubscribed types are still validated, but never reach the handler
+    CountingHandler handler;
+    assert(parser.parse(directory.data(), directory.size(), handler));
+    assert(!parser.parse(directory.data(), directory.size() - 1, handler));
+    
+    std::vector<uint8_t> exec(sizeof(ExecuteOrderMessage));
+    exec[0] = static_cast<uint8_t>(MessageType::EXECUTE_ORDER);
+    
+    std::vector<uint8_t> buffer;
+    append_frame(buffer, directory);
+    append_frame(buffer, make_add_order(6));
+    append_frame(buffer, exec);
+    append_frame(buffer, make_order_delete(6));
+    append_frame(buffer, std::vector<uint8_t>(7, 'Z'));
+    
+    auto result = parser.parse_batch(buffer.data(), buffer.size(), handler);
+    assert(result.messages_parsed == 2);
+    assert(result.messages_filtered == 2);
+    assert(result.messages_skipped == 1);
+    assert(handler.adds == 1 && handler.deletes == 1);
+    
+    size_t delivered = 0;
+    result = parser.parse_batch(buffer.data(), buffer.size(), [&](const ParsedMessage&) { ++delivered; });
+    assert(delivered == 2 && result.messages_filtered == 2);
+}
+
+TEST(symbol_filter) {
+    auto directory = [](uint16_t locate, const char* symbol) {
+        std::vector<uint8_t> msg(sizeof(StockDirectoryMessage));
+        auto* dir = reinterpret_cast<StockDirectoryMessage*>(msg.data());
+        dir->header.message_type = static_cast<uint8_t>(MessageType::STOCK_DIRECTORY);
+        dir->header.stock_locate = hton16(locate);
+        dir->stock.fill(' ');
+        std::memcpy(dir->stock.data(), symbol, std::strlen(symbol));
+        return msg;
+    };
+    
+    SymbolFilter filter;
+    filter.subscribe("AAPL");
+    assert(filter.accepts(0));  // Market-wide messages always pass
+    assert(!filter.accepts(10));
+    
+    ITCHParser parser;
+    parser.set_symbol_filter(&filter);
+    
+    std::vector<uint8_t> buffer;
+    append_frame(buffer, directory(10, "AAPL"));
+    append_frame(buffer, directory(11, "MSFT"));
+    append_frame(buffer, make_add_order(1, 10));
+    append_frame(buffer, make_add_order(2, 11));
+    
+    CountingHandler handler;
+    auto result = parser.parse_batch(buffer.data(), buffer.size(), handler);
+    assert(filter.accepts(10) && !filter.accepts(11));
+    assert(result.messages_parsed == 1);
+    assert(result.messages_filtered == 3);
+    assert(handler.adds == 1 && handler.last_add_ref == 1);
+    
+    // Runtime updates apply to the next message, using learned locates
+    filter.subscribe("MSFT");
+    filter.unsubscribe("AAPL");
+    auto msft = make_add_order(3, 11);
+    auto aapl = make_add_order(4, 10);
+    assert(parser.parse(msft.data(), msft.size()).has_value());
+    assert(!parser.parse(aapl.data(), aapl.size()).has_value());
+    assert(filter.accepted_count() == 2);
+    
+    // Symbol moved to a new locate
+    auto moved = directory(12, "MSFT");
+    assert(parser.parse(moved.data(), moved.size(), handler));
+    assert(filter.accepts(12) && !filter.accepts(11));
+    
+    assert(symbol_key("AAPL") == symbol_key(std::array<char, 8>{'A', 'A', 'P', 'L', ' ', ' ', ' ', ' '}));
+    
+    // A directly allowed locate survives directory messages for other symbols
+    filter.allow_locate(20);
+    auto other = directory(20, "IBM");
+    assert(parser.parse(other.data(), other.size(), handler));
+    assert(filter.accepts(20));
+    filter.block_locate(20);
+    assert(parser.parse(other.data(), other.size(), handler));
+    assert(!filter.accepts(20));
+}
+
+TEST(parser_timestamp_modes) {
+    std::vector<uint8_t> buffer;
+    for (uint64_t i = 0; i < 16; ++i) {
+        append_frame(buffer, make_add_order(i));
+    }
+    
+    std::vector<uint64_t> stamps;
+    auto collect = [&](const ParsedMessage& msg) { stamps.push_back(msg.parse_timestamp_ns); };
+    
+    BasicITCHParser<AllMessageTypes, TimestampMode::NONE> offline;
+    offline.parse_batch(buffer.data(), buffer.size(), collect);
+    assert(stamps.size() == 16);
+    for (uint64_t ts : stamps) assert(ts == 0);
+    
+    // Every message of a batch shares its receive time, including a frame
+    // completed from the previous stream chunk
+    BasicITCHParser<AllMessageTypes, TimestampMode::PER_BATCH> batched;
+    stamps.clear();
+    batched.parse_stream(buffer.data(), 5, collect);
+    batched.parse_stream(buffer.data() + 5, buffer.size() - 5, collect);
+    assert(stamps.size() == 16);
+    assert(stamps[0] != 0);
+    for (uint64_t ts : stamps) assert(ts == stamps[0]);
+    
+    stamps.clear();
+    batched.parse_batch(buffer.data(), buffer.size(), collect);
+    assert(stamps.front() == stamps.back() && stamps.front() > 0);
+    
+    // Typed handlers read the batch time from the parser
+    struct BatchStampHandler {
+        const BasicITCHParser<AllMessageTypes, TimestampMode::PER_BATCH>* parser;
+        std::vector<uint64_t>* stamps;
+        
+        void on_add_order(const AddOrderView&) {
+            stamps->push_back(parser->batch_timestamp());
+        }
+    };
+    stamps.clear();
+    BatchStampHandler typed{&batched, &stamps};
+    batched.parse_batch(buffer.data(), buffer.size(), typed);
+    assert(stamps.size() == 16 && stamps.front() == stamps.back() && stamps.front() > 0);
+    const uint64_t first_batch = stamps.front();
+    stamps.clear();
+    batched.parse_batch(buffer.data(), buffer.size(), typed);
+    assert(stamps.front() == stamps.back() && stamps.front() >= first_batch);
+    (void)first_batch;
+    
+    ITCHParser per_message;
+    stamps.clear();
+    per_message.parse_batch(buffer.data(), buffer.size(), collect);
+    for (size_t i = 1; i < stamps.size(); ++i) assert(stamps[i] >= stamps[i - 1]);
+    assert(stamps.back() > stamps.front());
+}
+
+std::vector<uint8_t> make_mold_packet(const char* session, uint64_t sequence, uint16_t count,
+                                      const std::vector<std::vector<uint8_t>>& messages = {}) {
+    std::vector<uint8_t> packet(sizeof(MoldUDP64Header));
+    auto* header = reinterpret_cast<MoldUDP64Header*>(packet.data());
+    std::memcpy(header->session.data(), session, header->session.size());
+    header->sequence_number = hton64(sequence);
+    header->message_count = hton16(count);
+    for (const auto& msg : messages) {
+        append_frame(packet, msg);
+    }
+    return packet;
+}
+
+TEST(moldudp64_sequencing) {
+    const char* session = "SESSION001";
+    ITCHParser parser;
+    MoldUDP64Decoder decoder;
+    CountingHandler handler;
+    
+    auto packet = make_mold_packet(session, 1, 2, {make_add_order(1), make_add_order(2)});
+    auto result = decoder.process(packet.data(), packet.size(), parser, handler);
+    assert(result.status == PacketStatus::DELIVERED && !result.has_gap());
+    assert(handler.adds == 2 && decoder.next_sequence() == 3);
+    
+    // Exact repeat is dropped
+    result = decoder.process(packet.data(), packet.size(), parser, handler);
+    assert(result.status == PacketStatus::DUPLICATE && handler.adds == 2);
+    
+    // Overlap: sequences 2-4, only 3 and 4 are new
+    packet = make_mold_packet(session, 2, 3, {make_add_order(2), make_add_order(3), make_order_delete(3)});
+    result = decoder.process(packet.data(), packet.size(), parser, handler);
+    assert(result.status == PacketStatus::DELIVERED);
+    assert(handler.adds == 3 && handler.last_add_ref == 3 && handler.deletes == 1);
+    assert(decoder.next_sequence() == 5);
+    
+    // Sequences 5-9 lost; the packet is still delivered
+    packet = make_mold_packet(session, 10, 1, {make_add_order(10)});
+    result = decoder.process(packet.data(), packet.size(), parser, handler);
+    assert(result.status == PacketStatus::DELIVERED);
+    assert(result.gap_start == 5 && result.gap_count == 5);
+    assert(handler.last_add_ref == 10 && decoder.next_sequence() == 11);
+    
+    // Heartbeats reveal gaps too
+    packet = make_mold_packet(session, 13, 0);
+    result = decoder.process(packet.data(), packet.size(), parser, handler);
+    assert(result.status == PacketStatus::HEARTBEAT && result.gap_count == 2);
+    
+    // Truncated packet delivers what it holds and reports malformed
+    packet = make_mold_packet(session, 13, 2, {make_add_order(13), make_add_order(14)});
+    packet.resize(packet.size() - 1);
+    result = decoder.process(packet.data(), packet.size(), parser, handler);
+    assert(result.status == PacketStatus::MALFORMED);
+    assert(decoder.next_sequence() == 14);
+    
+    packet = make_mold_packet("SESSION002", 20, 0);
+    assert(decoder.process(packet.data(), packet.size(), parser, handler).status == PacketStatus::SESSION_MISMATCH);
+    
+    packet = make_mold_packet(session, 14, MoldUDP64Decoder::END_OF_SESSION_COUNT);
+    assert(decoder.process(packet.data(), packet.size(), parser, handler).status == PacketStatus::END_OF_SESSION);
+    
+    const auto& stats = decoder.stats();
+    assert(stats.gaps == 2 && stats.messages_missed == 7);
+    assert(stats.messages_duplicate == 3);
+    assert(stats.messages_received == 6);
+}
+
+TEST(moldudp64_trailing_frames) {
+    const char* session = "SESSION001";
+    ITCHParser parser;
+    MoldUDP64Decoder decoder;
+    CountingHandler handler;
+    decoder.expect(1);
+    
+    // Frames past message_count are not part of the packet
+    auto packet = make_mold_packet(session, 1, 2, {make_add_order(1), make_add_order(2), make_add_order(3)});
+    auto result = decoder.process(packet.data(), packet.size(), parser, handler);
+    assert(result.status == PacketStatus::MALFORMED);
+    assert(result.batch.messages_parsed == 2);
+    assert(handler.adds == 2 && handler.last_add_ref == 2);
+    assert(decoder.next_sequence() == 3);
+    
+    // Same with an overlapping prefix: only sequence 3 is new
+    packet = make_mold_packet(session, 2, 2, {make_add_order(2), make_add_order(3), make_add_order(4)});
+    result = decoder.process(packet.data(), packet.size(), parser, handler);
+    assert(result.batch.messages_parsed == 1);
+    assert(handler.adds == 3 && handler.last_add_ref == 3);
+    assert(decoder.next_sequence() == 4);
+    assert(decoder.stats().messages_received == 3 && decoder.stats().messages_duplicate == 1);
+    (void)result;
+}
+
+void append_soup_packet(std::vector<uint8_t>& out, char type, const std::vector<uint8_t>& payload = {}) {
+    const uint16_t len = static_cast<uint16_t>(payload.size() + 1);
+    out.push_back(static_cast<uint8_t>(len >> 8));
+    out.push_back(static_cast<uint8_t>(len));
+    out.push_back(static_cast<uint8_t>(type));
+    out.insert(out.end(), payload.begin(), payload.end());
+}
+
+TEST(soupbintcp_loopback_session) {
+    // Stand-in server on an ephemeral loopback port
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int rc = bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    assert(rc == 0);
+    rc = listen(listener, 1);
+    assert(rc == 0);
+    (void)rc;
+    socklen_t addr_len = sizeof(addr);
+    getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &addr_len);
+    
+    // Enough data to wrap the receive ring several times
+    constexpr uint64_t MESSAGES = 20000;
+    std::vector<uint8_t> stream;
+    const std::string accepted = "SESSION001                   5";
+    append_soup_packet(stream, 'A', std::vector<uint8_t>(accepted.begin(), accepted.end()));
+    for (uint64_t i = 0; i < MESSAGES; ++i) {
+        append_soup_packet(stream, 'S', make_add_order(i));
+        if (i % 5000 == 0) {
+            append_soup_packet(stream, 'H');
+        }
+    }
+    append_soup_packet(stream, 'Z');
+    
+    std::string login_request;
+    std::thread server([&] {
+        int conn = accept(listener, nullptr, nullptr);
+        char buf[49];
+        size_t got = 0;
+        while (got < sizeof(buf)) {
+            ssize_t n = recv(conn, buf + got, sizeof(buf) - got, 0);
+            if (n <= 0) break;
+            got += static_cast<size_t>(n);
+        }
+        login_request.assign(buf, got);
+        
+        // Odd-sized writes so packets straddle reads and the ring end
+        for (size_t offset = 0; offset < stream.size(); offset += 7919) {
+            send(conn, stream.data() + offset, std::min<size_t>(7919, stream.size() - offset), MSG_NOSIGNAL);
+        }
+        close(conn);
+    });
+    
+    SoupBinTCPSession session(64 * 1024);
+    session.connect("127.0.0.1", ntohs(addr.sin_port));
+    session.login("user", "secret", "", 5);
+    
+    ITCHParser parser;
+    CountingHandler handler;
+    size_t parsed = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (session.state() != SoupBinTCPSession::State::ENDED &&
+           std::chrono::steady_clock::now() < deadline) {
+        parsed += session.poll(parser, handler).messages_parsed;
+    }
+    server.join();
+    close(listener);
+    
+    assert(login_request.size() == 49);
+    assert(login_request.substr(2, 7) == "Luser  ");
+    assert(login_request.substr(29, 20) == std::string(19, ' ') + "5");
+    
+    assert(session.state() == SoupBinTCPSession::State::ENDED);
+    assert(std::string(session.session().data(), 10) == "SESSION001");
+    assert(parsed == MESSAGES);
+    assert(handler.adds == static_cast<int>(MESSAGES));
+    assert(handler.last_add_ref == MESSAGES - 1);
+    assert(session.next_sequence() == 5 + MESSAGES);
+    assert(session.buffered_bytes() == 0);
+}
+
+// Ethernet + IPv4 + UDP frame around a payload, optionally VLAN-tagged
+std::vector<uint8_t> make_udp_frame(const std::vector<uint8_t>& payload, uint16_t dst_port, bool vlan = false) {
+    std::vector<uint8_t> frame(12, 0xEE);  // MAC addresses
+    if (vlan) {
+        frame.insert(frame.end(), {0x81, 0x00, 0x00, 0x64});
+    }
+    frame.insert(frame.end(), {0x08, 0x00});
+    
+    const uint16_t ip_len = static_cast<uint16_t>(20 + 8 + payload.size());
+    const uint16_t udp_len = static_cast<uint16_t>(8 + payload.size());
+    frame.insert(frame.end(), {
+        0x45, 0x00, static_cast<uint8_t>(ip_len >> 8), static_cast<uint8_t>(ip_len),
+        0x00, 0x00, 0x40, 0x00, 64, 17, 0x00, 0x00,
+        10, 0, 0, 1, 233, 54, 12, 111,
+        0x30, 0x39, static_cast<uint8_t>(dst_port >> 8), static_cast<uint8_t>(dst_port),
+        static_cast<uint8_t>(udp_len >> 8), static_cast<uint8_t>(udp_len), 0x00, 0x00});
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    return frame;
+}
+
+template<typename T>
+void put_le(std::vector<uint8_t>& out, T value) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+TEST(pcap_replay) {
+    const char* session = "SESSION001";
+    std::vector<std::vector<uint8_t>> frames = {
+        make_udp_frame(make_mold_packet(session, 1, 2, {make_add_order(1), make_add_order(2)}), 26400),
+        std::vector<uint8_t>(60, 0x06),  // Not IP
+        make_udp_frame(make_mold_packet(session, 3, 1, {make_order_delete(1)}), 26400, true),
+        make_udp_frame(make_mold_packet(session, 1, 1, {make_add_order(9)}), 5353),
+    };
+    // Non-IP frame: ethertype ARP
+    frames[1][12] = 0x08;
+    frames[1][13] = 0x06;
+    frames[0].resize(frames[0].size() + 4, 0);  // Ethernet trailer padding
+    
+    // Classic pcap, microsecond resolution
+    std::vector<uint8_t> pcap;
+    put_le<uint32_t>(pcap, 0xA1B2C3D4);
+    put_le<uint16_t>(pcap, 2);
+    put_le<uint16_t>(pcap, 4);
+    put_le<uint32_t>(pcap, 0);
+    put_le<uint32_t>(pcap, 0);
+    put_le<uint32_t>(pcap, 65535);
+    put_le<uint32_t>(pcap, 1);
+    for (size_t i = 0; i < frames.size(); ++i) {
+        put_le<uint32_t>(pcap, 1700000000);
+        put_le<uint32_t>(pcap, static_cast<uint32_t>(100 + i));
+        put_le<uint32_t>(pcap, static_cast<uint32_t>(frames[i].size()));
+        put_le<uint32_t>(pcap, static_cast<uint32_t>(frames[i].size()));
+        pcap.insert(pcap.end(), frames[i].begin(), frames[i].end());
+    }
+    
+    // pcapng with nanosecond interface resolution
+    std::vector<uint8_t> pcapng;
+    put_le<uint32_t>(pcapng, 0x0A0D0D0A);
+    put_le<uint32_t>(pcapng, 28);
+    put_le<uint32_t>(pcapng, 0x1A2B3C4D);
+    put_le<uint16_t>(pcapng, 1);
+    put_le<uint16_t>(pcapng, 0);
+    put_le<uint64_t>(pcapng, ~0ULL);
+    put_le<uint32_t>(pcapng, 28);
+    put_le<uint32_t>(pcapng, 1);
+    put_le<uint32_t>(pcapng, 32);
+    put_le<uint16_t>(pcapng, 1);
+    put_le<uint16_t>(pcapng, 0);
+    put_le<uint32_t>(pcapng, 65535);
+    put_le<uint16_t>(pcapng, 9);  // if_tsresol = 10^-9
+    put_le<uint16_t>(pcapng, 1);
+    pcapng.insert(pcapng.end(), {9, 0, 0, 0});
+    put_le<uint32_t>(pcapng, 0);  // opt_endofopt
+    put_le<uint32_t>(pcapng, 32);
+    for (size_t i = 0; i < frames.size(); ++i) {
+        const uint32_t padded = static_cast<uint32_t>((frames[i].size() + 3) & ~size_t{3});
+        const uint64_t ticks = 1700000000ULL * 1000000000ULL + 100 + i;
+        put_le<uint32_t>(pcapng, 6);
+        put_le<uint32_t>(pcapng, 32 + padded);
+        put_le<uint32_t>(pcapng, 0);
+        put_le<uint32_t>(pcapng, static_cast<uint32_t>(ticks >> 32));
+        put_le<uint32_t>(pcapng, static_cast<uint32_t>(ticks));
+        put_le<uint32_t>(pcapng, static_cast<uint32_t>(frames[i].size()));
+        put_le<uint32_t>(pcapng, static_cast<uint32_t>(frames[i].size()));
+        pcapng.insert(pcapng.end(), frames[i].begin(), frames[i].end());
+        pcapng.resize(pcapng.size() + (padded - frames[i].size()), 0);
+        put_le<uint32_t>(pcapng, 32 + padded);
+    }
+    
+    const std::pair<const char*, std::vector<uint8_t>*> files[] = {
+        {"test_capture.pcap", &pcap}, {"test_capture.pcapng", &pcapng}};
+    for (const auto& [path, bytes] : files) {
+        std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(bytes->data()), bytes->size());
+        
+        PcapReader reader(path);
+        const bool ns = (bytes == &pcapng);
+        assert(reader.format() == (ns ? PcapReader::Format::PCAPNG : PcapReader::Format::PCAP));
+        
+        CapturedPacket packet;
+        assert(reader.next(packet));
+        assert(packet.dst_port == 26400 && packet.dst_ipv4 == 0xE9360C6F);
+        assert(packet.length == sizeof(MoldUDP64Header) + 2 * (2 + sizeof(AddOrderMessage)));
+        assert(packet.timestamp_ns == 1700000000ULL * 1000000000ULL + (ns ? 100 : 100000));
+        assert(reader.next(packet) && packet.dst_port == 26400);
+        assert(reader.next(packet) && packet.dst_port == 5353);
+        assert(!reader.next(packet));
+        assert(reader.records_skipped() == 1);
+        
+        // Replay only the feed port through the session layer
+        reader.rewind();
+        reader.set_port_filter(26400);
+        ITCHParser parser;
+        MoldUDP64Decoder decoder;
+        CountingHandler handler;
+        std::vector<uint64_t> capture_times;
+        auto result = reader.replay(decoder, parser, [&](const ParsedMessage&) {
+            capture_times.push_back(reader.capture_timestamp_ns());
+        });
+        assert(result.packets == 2 && result.gaps == 0);
+        assert(result.batch.messages_parsed == 3);
+        assert(capture_times.size() == 3 && capture_times[0] == capture_times[1]);
+        assert(capture_times[2] > capture_times[1]);
+        
+        std::remove(path);
+    }
+}
+
+// Records order references in arrival order
+struct RefCollector {
+    std::vector<uint64_t> refs;
+    
+    void operator()(const ParsedMessage& msg) {
+        refs.push_back(msg.type == MessageType::ADD_ORDER ? msg.add_order.order_reference_number
+                                                          : msg.order_delete.order_reference_number);
+    }
+};
+
+TEST(parallel_file_parser) {
+    // Payload bytes that look like a frame (0x00 0x24 'A') make the
+    // resync chain do real work
+    std::vector<uint8_t> buffer;
+    for (uint64_t i = 0; i < 3000; ++i) {
+        auto msg = (i % 3 == 2) ? make_order_delete(i) : make_add_order(0x0024410000000000ULL | i);
+        append_frame(buffer, msg);
+    }
+    
+    RefCollector expected;
+    ITCHParser sequential;
+    sequential.parse_batch(buffer.data(), buffer.size(), expected);
+    
+    // Resync from inside a frame lands on the next real boundary
+    const size_t frame = 2 + sizeof(AddOrderMessage);
+    assert(ParallelFileParser::find_boundary(buffer.data(), buffer.size(), 5) == frame);
+    assert(ParallelFileParser::find_boundary(buffer.data(), buffer.size(), frame) == frame);
+    
+    ParallelFileParser parallel(buffer.data(), buffer.size(), 4);
+    for (size_t chunks : {1, 3, 7, 16, 64}) {
+        auto result = parallel.parse([](size_t) { return RefCollector{}; }, chunks);
+        assert(result.chunks.size() == chunks);
+        assert(result.misaligned_chunks == 0);
+        assert(result.total.messages_parsed == 3000);
+        assert(result.total.bytes_consumed == buffer.size());
+        
+        // Merging chunk results in file order reproduces the sequential parse
+        std::vector<uint64_t> merged;
+        for (const auto& chunk : result.chunks) {
+            merged.insert(merged.end(), chunk.handler.refs.begin(), chunk.handler.refs.end());
+        }
+        assert(merged == expected.refs);
+    }
+    
+    // Same through a mapped file
+    const char* path = "test_itch_file.bin";
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+    {
+        ParallelFileParser mapped(path, 3);
+        auto result = mapped.parse([](size_t) { return RefCollector{}; });
+        assert(result.total.messages_parsed == 3000 && result.misaligned_chunks == 0);
+        assert(result.chunks.front().handler.refs.front() == expected.refs.front());
+    }
+    std::remove(path);
+}
+
+TEST(gzip_stream_reader) {
+    std::vector<uint8_t> buffer;
+    for (uint64_t i = 0; i < 5000; ++i) {
+        auto msg = (i % 4 == 3) ? make_order_delete(i) : make_add_order(i);
+        append_frame(buffer, msg);
+    }
+    
+    RefCollector expected;
+    ITCHParser sequential;
+    sequential.parse_batch(buffer.data(), buffer.size(), expected);
+    
+    // Two concatenated gzip members, as produced by appending to a .gz
+    const char* path = "test_itch_stream.gz";
+    const size_t half = buffer.size() / 2;
+    gzFile out = gzopen(path, "wb");
+    gzwrite(out, buffer.data(), static_cast<unsigned>(half));
+    gzclose(out);
+    out = gzopen(path, "ab");
+    gzwrite(out, buffer.data() + half, static_cast<unsigned>(buffer.size() - half));
+    gzclose(out);
+    
+    {
+        // Small blocks so many frames straddle a block boundary
+        GzipStreamReader reader(path, 4096, 3);
+        auto parser = std::make_unique<ITCHParser>();
+        RefCollector collected;
+        BatchResult result = reader.parse(*parser, collected);
+        assert(!reader.failed());
+        assert(result.messages_parsed == 5000);
+        assert(parser->pending_bytes() == 0);
+        assert(collected.refs == expected.refs);
+        assert(reader.stats().decompressed_bytes == buffer.size());
+        assert(reader.stats().compressed_bytes > 0);
+    }
+    
+    // A truncated file reports failure after delivering what it could
+    std::vector<char> compressed;
+    {
+        std::ifstream in(path, std::ios::binary);
+        compressed.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    const char* truncated_path = "test_itch_truncated.gz";
+    std::ofstream(truncated_path, std::ios::binary).write(compressed.data(), compressed.size() - 16);
+    {
+        GzipStreamReader reader(truncated_path, 4096, 2);
+        auto parser = std::make_unique<ITCHParser>();
+        RefCollector collected;
+        reader.parse(*parser, collected);
+        assert(reader.failed());
+        assert(!reader.error().empty());
+        assert(collected.refs.size() < expected.refs.size());
+    }
+    
+    std::remove(path);
+    std::remove(truncated_path);
+}
+
+// Records (locate, order reference) per shard, plus market-wide events
+struct ShardRecorder {
+    std::vector<std::pair<uint16_t, uint64_t>> orders;
+    size_t system_events = 0;
+    
+    void operator()(const ParsedMessage& msg) {
+        if (msg.type == MessageType::SYSTEM_EVENT) {
+            ++system_events;
+        } else if (msg.type == MessageType::ADD_ORDER) {
+            orders.emplace_back(msg.add_order.header.stock_locate, msg.add_order.order_reference_number);
+        } else {
+            orders.emplace_back(msg.order_delete.header.stock_locate, msg.order_delete.order_reference_number);
+        }
+    }
+};
+
+TEST(sharded_pipeline) {
+    std::vector<uint8_t> event(sizeof(SystemEventMessage));
+    auto* system_event = reinterpret_cast<SystemEventMessage*>(event.data());
+    system_event->header.message_type = static_cast<uint8_t>(MessageType::SYSTEM_EVENT);
+    system_event->header.stock_locate = 0;
+    system_event->event_code = 'O';
+    
+    std::vector<uint8_t> buffer;
+    append_frame(buffer, event);
+    std::map<uint16_t, std::vector<uint64_t>> expected;
+    for (uint64_t i = 0; i < 20000; ++i) {
+        const uint16_t locate = static_cast<uint16_t>(1 + (i * 7) % 13);
+        append_frame(buffer, (i % 3 == 2) ? make_order_delete(i, locate) : make_add_order(i, locate));
+        expected[locate].push_back(i);
+    }
+    append_frame(buffer, std::vector<uint8_t>(7, 'Z'));  // Malformed, dropped by the router
+    
+    // A small ring makes the router wait on full rings
+    ShardedPipeline<ShardRecorder, ITCHParser, 64> pipeline(3, [](size_t) { return ShardRecorder{}; });
+    BatchResult routed = pipeline.route_batch(buffer.data(), buffer.size());
+    pipeline.finish();
+    
+    assert(routed.bytes_consumed == buffer.size());
+    assert(routed.messages_parsed == 20001);
+    assert(routed.messages_skipped == 1);
+    assert(pipeline.stats().broadcast == 1 && pipeline.stats().routed == 20000);
+    
+    // Each symbol lives on one shard, in its original order
+    std::map<uint16_t, std::vector<uint64_t>> seen;
+    for (size_t shard = 0; shard < pipeline.workers(); ++shard) {
+        const ShardRecorder& recorder = pipeline.handler(shard);
+        assert(recorder.system_events == 1);
+        assert(pipeline.result(shard).messages_parsed == recorder.orders.size() + 1);
+        for (const auto& [locate, ref] : recorder.orders) {
+            assert(pipeline.shard_of(locate) == shard);
+            seen[locate].push_back(ref);
+        }
+    }
+    assert(seen == expected);
+    
+    // With the workers gone nothing drains the rings, so routing drops
+    routed = pipeline.route_batch(buffer.data(), buffer.size());
+    assert(routed.messages_parsed == 0 && routed.messages_skipped == 20002);
+    assert(pipeline.stats().dropped == 20002 && pipeline.stats().routed == 20000);
+}
+
+std::vector<uint8_t> make_book_add(uint64_t ref, char side, uint32_t shares, uint32_t price, uint16_t locate = 1) {
+    auto msg = make_add_order(ref, locate);
+    auto* order = reinterpret_cast<AddOrderMessage*>(msg.data());
+    order->buy_sell_indicator = static_cast<uint8_t>(side);
+    order->shares = hton32(shares);
+    order->price = hton32(price);
+    return msg;
+}
+
+std::vector<uint8_t> make_book_execute(uint64_t ref, uint32_t shares) {
+    std::vector<uint8_t> msg(sizeof(ExecuteOrderMessage));
+    auto* exec = reinterpret_cast<ExecuteOrderMessage*>(msg.data());
+    exec->header.message_type = static_cast<uint8_t>(MessageType::EXECUTE_ORDER);
+    exec->header.stock_locate = hton16(1);
+    exec->order_reference_number = hton64(ref);
+    exec->executed_shares = hton32(shares);
+    return msg;
+}
+
+std::vector<uint8_t> make_book_cancel(uint64_t ref, uint32_t shares) {
+    std::vector<uint8_t> msg(sizeof(OrderCancelMessage));
+    auto* cancel = reinterpret_cast<OrderCancelMessage*>(msg.data());
+    cancel->header.message_type = static_cast<uint8_t>(MessageType::ORDER_CANCEL);
+    cancel->header.stock_locate = hton16(1);
+    cancel->order_reference_number = hton64(ref);
+    cancel->cancelled_shares = hton32(shares);
+    return msg;
+}
+
+std::vector<uint8_t> make_book_replace(uint64_t ref, uint64_t new_ref, uint32_t shares, uint32_t price) {
+    std::vector<uint8_t> msg(sizeof(OrderReplaceMessage));
+    auto* replace = reinterpret_cast<OrderReplaceMessage*>(msg.data());
+    replace->header.message_type = static_cast<uint8_t>(MessageType::ORDER_REPLACE);
+    replace->header.stock_locate = hton16(1);
+    replace->original_order_reference_number = hton64(ref);
+    replace->new_order_reference_number = hton64(new_ref);
+    replace->shares = hton32(shares);
+    replace->price = hton32(price);
+    return msg;
+}
+
+TEST(symbol_directory) {
+    auto directory = [](uint16_t locate, const char* symbol, uint32_t round_lot = 100, uint8_t etp = 'N') {
+        std::vector<uint8_t> msg(sizeof(StockDirectoryMessage));
+        auto* dir = reinterpret_cast<StockDirectoryMessage*>(msg.data());
+        dir->header.message_type = static_cast<uint8_t>(MessageType::STOCK_DIRECTORY);
+        dir->header.stock_locate = hton16(locate);
+        dir->stock.fill(' ');
+        std::memcpy(dir->stock.data(), symbol, std::strlen(symbol));
+        dir->round_lot_size = hton32(round_lot);
+        dir->luld_reference_price_tier = '1';
+        dir->etp_flag = etp;
+        dir->etp_leverage_factor = hton32(etp == 'Y' ? 2 : 0);
+        return msg;
+    };
+    
+    auto symbols = std::make_unique<SymbolDirectory>();
+    auto parser = std::make_unique<ITCHParser>();
+    std::vector<uint8_t> buffer;
+    append_frame(buffer, directory(1, "AAPL"));
+    append_frame(buffer, directory(2, "MSFT"));
+    append_frame(buffer, directory(3, "SSO", 10, 'Y'));
+    parser->parse_batch(buffer.data(), buffer.size(), *symbols);
+    
+    assert(symbols->size() == 3 && symbols->symbol(1) == "AAPL" && symbols->symbol(4).empty());
+    const SymbolInfo* etf = symbols->find(3);
+    assert(etf != nullptr && etf->symbol() == "SSO" && etf->round_lot_size == 10);
+    assert(etf->etp_flag == 'Y' && etf->etp_leverage_factor == 2 && etf->luld_reference_price_tier == '1');
+    assert(symbols->find(4) == nullptr);
+    assert(symbols->locate("MSFT") == 2 && symbols->locate("MSF") == 0 && symbols->locate(etf->stock) == 3);
+    
+    // A locate re-listed under another symbol, and a symbol moved to a new locate
+    SymbolInfo renamed;
+    std::memcpy(renamed.stock.data(), "GOOG    ", 8);
+    symbols->add(2, renamed);
+    assert(symbols->locate("MSFT") == 0 && symbols->locate("GOOG") == 2);
+    SymbolInfo moved = *symbols->find(1);
+    symbols->add(5, moved);
+    assert(symbols->locate("AAPL") == 5 && symbols->find(1) == nullptr && symbols->size() == 3);
+    
+    // A full listing's worth of symbols resolves both ways
+    for (uint16_t locate = 10; locate < 12010; ++locate) {
+        const std::string symbol = "S" + std::to_string(locate);
+        SymbolInfo info;
+        info.stock.fill(' ');
+        std::memcpy(info.stock.data(), symbol.data(), symbol.size());
+        symbols->add(locate, info);
+    }
+    bool resolved = true;
+    for (uint16_t locate = 10; locate < 12010; ++locate) {
+        const std::string symbol = "S" + std::to_string(locate);
+        resolved &= symbols->locate(symbol) == locate && symbols->symbol(locate) == symbol;
+    }
+    assert(resolved && symbols->size() == 12003);
+    
+    symbols->clear();
+    assert(symbols->size() == 0 && symbols->locate("GOOG") == 0 && symbols->find(3) == nullptr);
+    (void)etf;
+    (void)resolved;
+}
+
+TEST(order_book_manager) {
+    BookManager books(1024);
+    auto parser = std::make_unique<ITCHParser>();
+    auto apply = [&](const std::vector<uint8_t>& msg) {
+        bool ok = parser->parse(msg.data(), msg.size(), books);
+        assert(ok);
+        (void)ok;
+    };
+    
+    apply(make_book_add(1, 'B', 100, 1000000));
+    apply(make_book_add(2, 'B', 200, 1000000));
+    apply(make_book_add(3, 'B', 300, 999900));
+    apply(make_book_add(4, 'S', 400, 1000100));
+    apply(make_book_add(5, 'S', 500, 1000200));
+    apply(make_book_add(6, 'S', 50, 1000000, 2));  // Another symbol
+    
+    const OrderBook* book = books.book(1);
+    assert(book != nullptr && books.book(3) == nullptr);
+    BestBidOffer top = book->bbo();
+    assert(top.bid_price == 1000000 && top.bid_shares == 300);
+    assert(top.ask_price == 1000100 && top.ask_shares == 400);
+    assert(book->depth(Side::BUY) == 2 && book->depth(Side::SELL) == 2);
+    assert(books.book(2)->bbo().ask_shares == 50 && books.book(2)->bbo().bid_price == 0);
+    
+    // Time priority within a level
+    assert(book->best_bid()->head->reference == 1 && book->best_bid()->tail->reference == 2);
+    
+    // Partial then full execution of the oldest bid
+    apply(make_book_execute(1, 40));
+    assert(books.find_order(1)->shares == 60 && book->bbo().bid_shares == 260);
+    apply(make_book_execute(1, 60));
+    assert(books.find_order(1) == nullptr && book->best_bid()->head->reference == 2);
+    
+    // Partial cancel keeps priority; replace loses it and can move price
+    apply(make_book_cancel(2, 150));
+    assert(book->bbo().bid_shares == 50);
+    apply(make_book_replace(2, 20, 75, 999900));
+    assert(books.find_order(2) == nullptr && books.find_order(20)->side == Side::BUY);
+    top = book->bbo();
+    assert(top.bid_price == 999900 && top.bid_shares == 375 && book->depth(Side::BUY) == 1);
+    assert(book->best_bid()->tail->reference == 20);
+    
+    // Deleting the best offer promotes the next level
+    std::vector<uint8_t> del = make_order_delete(4);
+    apply(del);
+    assert(book->bbo().ask_price == 1000200 && book->bbo().ask_shares == 500);
+    
+    // Unknown references are counted, not applied
+    apply(make_order_delete(999));
+    assert(books.stats().unknown_orders == 1);
+    assert(books.order_count() == 4);
+    
+    std::vector<uint64_t> bid_prices;
+    book->for_each_level(Side::BUY, [&](const PriceLevel& level) {
+        bid_prices.push_back(level.price);
+        return true;
+    });
+    assert(bid_prices == std::vector<uint64_t>{999900});
+    
+    // Orders and levels come from the pools and go back to them
+    assert(books.order_pool_stats().in_use == 4 && books.order_pool_stats().high_water == 6);
+    assert(books.level_pool_stats().in_use == 3);
+    
+    books.clear();
+    assert(books.order_count() == 0 && books.book(1) == nullptr);
+    assert(books.order_pool_stats().in_use == 0 && books.level_pool_stats().in_use == 0);
+}
+
+TEST(object_pool) {
+    struct Node {
+        uint64_t key;
+        uint32_t value;
+    };
+    
+    // Small slabs so the pool has to map more than one
+    ObjectPool<Node> pool(0, 4096);
+    std::vector<Node*> nodes;
+    for (uint64_t i = 0; i < 1000; ++i) {
+        nodes.push_back(pool.create(Node{i, static_cast<uint32_t>(i * 2)}));
+    }
+    assert(pool.stats().in_use == 1000 && pool.stats().slabs > 1);
+    assert(nodes[0]->key == 0 && nodes[999]->value == 1998);
+    
+    // Freed nodes are reused most recent first, before any fresh slot
+    Node* last_freed = nodes[500];
+    pool.destroy(nodes[10]);
+    pool.destroy(last_freed);
+    const size_t slabs = pool.stats().slabs;
+    Node* reused = pool.create(Node{7, 7});
+    Node* reused_older = pool.create(Node{8, 8});
+    assert(reused == last_freed && reused_older == nodes[10]);
+    assert(pool.stats().slabs == slabs);
+    assert(pool.stats().in_use == 1000 && pool.stats().high_water == 1000);
+    assert(pool.stats().allocations == 1002);
+    
+    // Clearing rewinds onto the same slabs
+    pool.clear();
+    Node* first = pool.create(Node{1, 1});
+    assert(first == nodes[0] && pool.stats().slabs == slabs);
+    (void)reused;
+    (void)reused_older;
+    (void)first;
+}
+
+TEST(object_pool_huge_page_slabs) {
+    // 48-byte slots leave the last 32 bytes of a huge page unused; the slab
+    // must still be mapped as a whole huge page
+    static_assert(sizeof(BookOrder) == 48);
+    ObjectPool<BookOrder> pool(1);
+    assert(pool.stats().huge_pages || !SystemUtils::has_huge_pages());
+    assert(pool.stats().slabs == 1);
+    assert(pool.stats().capacity == SystemUtils::HUGE_PAGE_SIZE / sizeof(BookOrder));
+}
+
+TEST(price_ladder) {
+    struct Level {
+        uint32_t price;
+    };
+    std::deque<Level> storage;
+    auto make = [&](uint32_t price) {
+        storage.push_back(Level{price});
+        return &storage.back();
+    };
+    auto prices = [](const auto& ladder) {
+        std::vector<uint32_t> out;
+        ladder.for_each([&](const Level& level) {
+            out.push_back(level.price);
+            return true;
+        });
+        return out;
+    };
+    
+    PriceLadder<Level, true> bids;
+    Level* mid = make(1000000);
+    Level* below = make(999900);
+    Level* top = make(1000100);
+    bids.insert(mid);
+    bids.insert(below);
+    bids.insert(top);
+    assert(bids.best() == top && bids.find(999900) == below && bids.find(999800) == nullptr);
+    bids.erase(top);
+    assert(bids.best() == mid && bids.outlier_count() == 0);
+    
+    // Sub-penny and deep prices fall back to the sorted map
+    Level* sub_penny = make(1000050);
+    Level* deep = make(900000);
+    bids.insert(sub_penny);
+    bids.insert(deep);
+    assert(bids.best() == sub_penny && bids.outlier_count() == 2 && bids.reanchors() == 1);
+    assert(prices(bids) == (std::vector<uint32_t>{1000050, 1000000, 999900, 900000}));
+    bids.erase(sub_penny);
+    assert(bids.best() == mid);
+    
+    // A new best beyond the window slides it and spills the old levels
+    Level* rally = make(1100000);
+    bids.insert(rally);
+    assert(bids.best() == rally && bids.reanchors() == 2 && bids.outlier_count() == 3);
+    bids.erase(rally);
+    assert(bids.best() == mid);
+    Level* back = make(1000100);
+    bids.insert(back);
+    assert(bids.reanchors() == 3 && bids.outlier_count() == 1 && bids.size() == 4);
+    assert(prices(bids) == (std::vector<uint32_t>{1000100, 1000000, 999900, 900000}));
+    
+    // Random walk against a sorted reference, both sides
+    PriceLadder<Level, false> asks;
+    std::map<uint32_t, Level*> ask_reference;
+    std::mt19937 rng(11);
+    uint32_t walk = 500000;
+    for (int step = 0; step < 20000; ++step) {
+        walk += static_cast<uint32_t>(rng() % 201) - 100;
+        const uint32_t price = walk + static_cast<uint32_t>(rng() % 40) * (rng() % 8 == 0 ? 1 : 100);
+        if (rng() % 2 == 0 && ask_reference.count(price) == 0) {
+            Level* level = make(price);
+            asks.insert(level);
+            ask_reference.emplace(price, level);
+        } else if (!ask_reference.empty()) {
+            auto it = ask_reference.lower_bound(price);
+            if (it == ask_reference.end()) {
+                it = ask_reference.begin();
+            }
+            asks.erase(it->second);
+            ask_reference.erase(it);
+        }
+        assert(asks.size() == ask_reference.size());
+        assert(ask_reference.empty() ? asks.best() == nullptr : asks.best() == ask_reference.begin()->second);
+    }
+    std::vector<uint32_t> expected;
+    for (const auto& [price, level] : ask_reference) {
+        expected.push_back(price);
+    }
+    assert(prices(asks) == expected && asks.reanchors() > 1);
+    (void)below;
+    (void)deep;
+}
+
+TEST(top_of_book) {
+    auto table = std::make_unique<TopOfBookTable>();
+    assert(table->version(1) == 0 && table->read(1).bid_price == 0);
+    
+    // The manager publishes BBO changes only
+    BookManager books(1024);
+    books.set_top_of_book(table.get());
+    auto parser = std::make_unique<ITCHParser>();
+    std::vector<uint8_t> bid = make_book_add(1, 'B', 100, 1000000);
+    std::vector<uint8_t> deep_bid = make_book_add(2, 'B', 100, 990000);
+    std::vector<uint8_t> ask = make_book_add(3, 'S', 300, 1000100);
+    bool ok = parser->parse(bid.data(), bid.size(), books) &&
+              parser->parse(deep_bid.data(), deep_bid.size(), books) &&
+              parser->parse(ask.data(), ask.size(), books);
+    assert(ok);
+    TopOfBook top = table->read(1);
+    assert(top.bid_price == 1000000 && top.bid_shares == 100);
+    assert(top.ask_price == 1000100 && top.ask_shares == 300);
+    assert(top.version == 2 && table->version(2) == 0);
+    
+    std::vector<uint8_t> del = make_order_delete(1);
+    ok = parser->parse(del.data(), del.size(), books);
+    assert(ok);
+    top = table->read(1);
+    assert(top.bid_price == 990000 && top.version == 3);
+    const bool changed = table->publish(1, 990000, 100, 1000100, 300, 42);
+    assert(!changed && table->version(1) == 3);
+    
+    // A reader racing the writer never sees a torn quote
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (uint32_t i = 1; i <= 100000; ++i) {
+            table->publish(7, i, i, i + 1, i, i);
+        }
+        done.store(true, std::memory_order_release);
+    });
+    uint64_t last_version = 0;
+    bool consistent = true;
+    while (!done.load(std::memory_order_acquire) || last_version < 100000) {
+        const TopOfBook quote = table->read(7);
+        consistent &= quote.bid_shares == quote.bid_price && quote.ask_price == quote.bid_price + (quote.version ? 1 : 0);
+        consistent &= quote.timestamp == quote.bid_price && quote.version >= last_version;
+        last_version = quote.version;
+    }
+    writer.join();
+    assert(consistent && table->read(7).bid_price == 100000);
+    (void)ok;
+    (void)changed;
+    (void)consistent;
+}
+
+TEST(book_checkpoint) {
+    const char* path = "test_book_checkpoint.bin";
+    std::vector<uint8_t> buffer;
+    std::vector<uint8_t> directory(sizeof(StockDirectoryMessage));
+    auto* dir = reinterpret_cast<StockDirectoryMessage*>(directory.data());
+    dir->header.message_type = static_cast<uint8_t>(MessageType::STOCK_DIRECTORY);
+    dir->header.stock_locate = hton16(1);
+    std::memcpy(dir->stock.data(), "MSFT    ", 8);
+    append_frame(buffer, directory);
+    append_frame(buffer, make_book_add(1, 'B', 100, 1000000));
+    append_frame(buffer, make_book_add(2, 'B', 200, 1000000));
+    append_frame(buffer, make_book_add(3, 'B', 300, 999900));
+    append_frame(buffer, make_book_add(4, 'S', 400, 1000100));
+    append_frame(buffer, make_book_add(5, 'S', 500, 1000050, 2));
+    append_frame(buffer, make_book_execute(1, 30));
+    
+    auto parser = std::make_unique<ITCHParser>();
+    BookManager live(1024);
+    parser->parse_batch(buffer.data(), buffer.size(), live);
+    const CheckpointInfo saved = BookCheckpoint::save(live, path, 777);
+    assert(saved.orders == 5 && saved.books == 2 && saved.symbols == 1);
+    
+    // Restart: levels, priority, symbols and counters come back as they were
+    BookManager restored(1024);
+    auto table = std::make_unique<TopOfBookTable>();
+    restored.set_top_of_book(table.get());
+    const CheckpointInfo loaded = BookCheckpoint::load(restored, path);
+    assert(loaded.sequence == 777 && loaded.orders == 5);
+    assert(restored.symbol(1) == "MSFT" && restored.symbol(2).empty());
+    assert(restored.order_count() == 5 && restored.stats().adds == 5 && restored.stats().executions == 1);
+    const OrderBook* book = restored.book(1);
+    assert(book != nullptr && book->depth(Side::BUY) == 2 && book->depth(Side::SELL) == 1);
+    assert(book->best_bid()->head->reference == 1 && book->best_bid()->tail->reference == 2);
+    assert(book->bbo().bid_shares == 270 && restored.find_order(1)->shares == 70);
+    assert(book->timestamp() == live.book(1)->timestamp());
+    assert(restored.book(2)->bbo().ask_price == 1000050);
+    assert(table->read(1).bid_shares == 270 && table->read(2).ask_shares == 500);
+    
+    // The feed carries on from the restored state
+    std::vector<uint8_t> execute = make_book_execute(1, 70);
+    bool ok = parser->parse(execute.data(), execute.size(), restored);
+    assert(ok && book->best_bid()->head->reference == 2);
+    
+    // Truncated files are rejected
+    truncate(path, 100);
+    bool rejected = false;
+    try {
+        BookCheckpoint::load(restored, path);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+    std::remove(path);
+    (void)saved;
+    (void)loaded;
+    (void)book;
+    (void)ok;
+    (void)rejected;
+}
+
+TEST(bar_aggregator) {
+    auto trade = [](uint16_t locate, uint32_t price, uint32_t shares, uint64_t timestamp) {
+        std::vector<uint8_t> msg(sizeof(TradeMessage));
+        auto* wire = reinterpret_cast<TradeMessage*>(msg.data());
+        wire->header.message_type = static_cast<uint8_t>(MessageType::TRADE);
+        wire->header.stock_locate = hton16(locate);
+        wire->header.timestamp = hton48(timestamp);
+        wire->price = hton32(price);
+        wire->shares = hton32(shares);
+        return msg;
+    };
+    auto execution = [](uint16_t locate, uint32_t price, uint32_t shares, uint64_t timestamp, char printable) {
+        std::vector<uint8_t> msg(sizeof(ExecuteOrderWithPriceMessage));
+        auto* wire = reinterpret_cast<ExecuteOrderWithPriceMessage*>(msg.data());
+        wire->header.message_type = static_cast<uint8_t>(MessageType::EXECUTE_ORDER_WITH_PRICE);
+        wire->header.stock_locate = hton16(locate);
+        wire->header.timestamp = hton48(timestamp);
+        wire->execution_price = hton32(price);
+        wire->executed_shares = hton32(shares);
+        wire->printable = static_cast<uint8_t>(printable);
+        return msg;
+    };
+    
+    std::vector<Bar> bars;
+    size_t batches = 0;
+    auto sink = [&](const Bar* batch, size_t count) {
+        bars.insert(bars.end(), batch, batch + count);
+        ++batches;
+    };
+    using Aggregator = BarAggregator<decltype(sink)>;
+    auto aggregator = std::make_unique<Aggregator>(Aggregator::ONE_SECOND_NS, sink);
+    
+    const uint64_t second = Aggregator::ONE_SECOND_NS;
+    std::vector<uint8_t> buffer;
+    append_frame(buffer, trade(1, 1000000, 100, second + 100));
+    append_frame(buffer, trade(1, 1050000, 200, second + 200));
+    append_frame(buffer, execution(1, 950000, 100, second + 300, 'Y'));
+    append_frame(buffer, execution(1, 10, 999, second + 400, 'N'));  // Not printed
+    append_frame(buffer, trade(2, 500000, 10, second + 500));
+    append_frame(buffer, trade(1, 1020000, 100, second + 600));
+    append_frame(buffer, trade(2, 510000, 30, 2 * second + 1));    // Rolls the first second
+    auto parser = std::make_unique<ITCHParser>();
+    parser->parse_batch(buffer.data(), buffer.size(), *aggregator);
+    
+    assert(batches == 1 && bars.size() == 2);
+    const Bar& first = bars[0];
+    assert(first.stock_locate == 1 && first.start == second && first.trades == 4);
+    assert(first.open == 1000000 && first.high == 1050000 && first.low == 950000 && first.close == 1020000);
+    assert(first.volume == 500 && first.vwap() == 1014000.0);
+    assert(bars[1].stock_locate == 2 && bars[1].volume == 10 && bars[1].open == bars[1].close);
+    
+    // Quiet intervals produce no bars; flush closes the open one
+    aggregator->advance(5 * second);
+    assert(batches == 2 && bars.size() == 3 && bars[2].start == 2 * second && bars[2].volume == 30);
+    aggregator->flush();
+    assert(batches == 2 && aggregator->stats().bars == 3 && aggregator->stats().trades == 6);
+    (void)first;
+}
+
+TEST(flat_order_map) {
+    // Starts small so it rehashes, and churns enough to wrap probe runs
+    // around the end of the table and exercise backward-shift erase
+    FlatOrderMap<uint32_t> map;
+    std::unordered_map<uint64_t, uint32_t> reference;
+    std::mt19937_64 rng(7);
+    std::vector<uint64_t> keys;
+    uint64_t next_key = 1;
+    
+    for (int step = 0; step < 200000; ++step) {
+        const unsigned action = static_cast<unsigned>(rng() % 10);
+        if (keys.empty() || action < 5) {
+            const uint64_t key = (step % 5 == 0) ? rng() : next_key++;
+            const bool inserted = map.insert(key, static_cast<uint32_t>(step));
+            const bool expected = reference.emplace(key, static_cast<uint32_t>(step)).second;
+            assert(inserted == expected);
+            (void)expected;
+            if (inserted) {
+                keys.push_back(key);
+            }
+        } else if (action < 8) {
+            const size_t pick = rng() % keys.size();
+            uint32_t value = 0;
+            const bool extracted = map.extract(keys[pick], value);
+            assert(extracted && value == reference[keys[pick]]);
+            reference.erase(keys[pick]);
+            keys[pick] = keys.back();
+            keys.pop_back();
+            (void)extracted;
+        } else {
+            const uint64_t key = keys[rng() % keys.size()];
+            const uint32_t* value = map.find(key);
+            assert(value != nullptr && *value == reference[key]);
+            assert(map.find(key + (1ULL << 62)) == nullptr);
+            (void)value;
+        }
+        assert(map.size() == reference.size());
+    }
+    
+    // Every surviving entry is still reachable after all the shifting
+    size_t visited = 0;
+    map.for_each([&](uint64_t key, uint32_t value) {
+        assert(reference.at(key) == value);
+        ++visited;
+    });
+    assert(visited == reference.size());
+    size_t erased = 0;
+    for (uint64_t key : keys) {
+        erased += map.erase(key);
+    }
+    assert(erased == keys.size() && map.empty());
+    assert(map.find(keys.front()) == nullptr);
+    (void)erased;
+    
+    // Keys that all land on one home slot grow the table rather than
+    // overflowing the probe distance stored in a tag
+    FlatOrderMap<uint32_t> clustered;
+    for (uint64_t j = 0; j < 200; ++j) {
+        clustered.insert(j << 50, static_cast<uint32_t>(j));
+    }
+    assert(clustered.size() == 200 && clustered.capacity() > 256);
+    for (uint64_t j = 0; j < 200; ++j) {
+        const uint32_t* value = clustered.find(j << 50);
+        assert(value != nullptr && *value == j);
+        (void)value;
+    }
+    
+    // Preallocation sizes the table up front
+    FlatOrderMap<uint32_t> sized(1000000);
+    assert(sized.capacity() >= 1000000 + 1000000 / 7);
+}
+
 TEST(async_logger_basic) {
     // Note: Full async logger test disabled to avoid stack overflow in test environment
     // The async logger works correctly in production use (see demo and benchmark)
@@ -189,6 +1658,275 @@ TEST(async_logger_basic) {
     std::remove("test_output.bin");
 }
 
+TEST(columnar_log) {
+    const std::string path = "test_columnar.bin";
+    ITCHParser parser;
+    std::vector<ParsedMessage> messages;
+    for (uint64_t i = 0; i < 150; ++i) {
+        auto msg = make_book_add(1000 + i, i % 2 ? 'S' : 'B', 100 + i, 500000 + i, static_cast<uint16_t>(i % 7));
+        reinterpret_cast<AddOrderMessage*>(msg.data())->header.timestamp = hton48(34200000000000ULL + i);
+        messages.push_back(*parser.parse(msg.data(), msg.size()));
+        if (i % 15 == 0) {
+            auto exec = make_book_execute(1000 + i, 10);
+            messages.push_back(*parser.parse(exec.data(), exec.size()));
+        }
+    }
+    
+    // Row groups of 64: add orders fill two and leave a partial one
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    assert(fd >= 0);
+    {
+        ColumnarWriter writer(fd, 64);
+        for (const ParsedMessage& msg : messages) {
+            writer.append(msg);
+        }
+        assert(writer.row_groups() == 2);
+        writer.finish();
+        assert(writer.ok());
+        assert(writer.rows_written() == messages.size());
+        assert(writer.row_groups() == 4);
+    }
+    ::close(fd);
+    
+    {
+        ColumnarLogReader reader(path);
+        assert(reader.row_group_count() == 4);
+        assert(reader.rows(MessageType::ADD_ORDER) == 150);
+        assert(reader.rows(MessageType::EXECUTE_ORDER) == 10);
+        
+        const int price = ColumnarLogReader::column_index(MessageType::ADD_ORDER, "price");
+        const int shares = ColumnarLogReader::column_index(MessageType::ADD_ORDER, "shares");
+        const int locate = ColumnarLogReader::column_index(MessageType::ADD_ORDER, "stock_locate");
+        assert(price > 0 && shares > 0 && locate > 0);
+        assert(ColumnarLogReader::column_index(MessageType::ADD_ORDER, "match_number") == -1);
+        
+        uint64_t row = 0;
+        for (size_t group = 0; group < reader.row_group_count(); ++group) {
+            const RowGroupMeta& meta = reader.row_group(group);
+            if (meta.message_type != static_cast<uint8_t>(MessageType::ADD_ORDER)) {
+                continue;
+            }
+            assert(meta.offset % 64 == 0);
+            assert(meta.first_timestamp == 34200000000000ULL + row);
+            const uint64_t* timestamps = reader.column_as<uint64_t>(group, 0);
+            const uint32_t* prices = reader.column_as<uint32_t>(group, price);
+            const uint32_t* sizes = reader.column_as<uint32_t>(group, shares);
+            const uint16_t* locates = reader.column_as<uint16_t>(group, locate);
+            for (uint32_t i = 0; i < meta.rows; ++i, ++row) {
+                assert(timestamps[i] == 34200000000000ULL + row);
+                assert(prices[i] == 500000 + row);
+                assert(sizes[i] == 100 + row);
+                assert(locates[i] == row % 7);
+            }
+            assert(meta.last_timestamp == 34200000000000ULL + row - 1);
+        }
+        assert(row == 150);
+    }
+    
+    // Logger mode: same file format, written from the logger thread
+    {
+        AsyncLogger* logger = new AsyncLogger(path, AsyncLogger::WriteMode::COLUMNAR);
+        logger->start();
+        for (const ParsedMessage& msg : messages) {
+            while (!logger->log(msg)) {
+                std::this_thread::yield();
+            }
+        }
+        logger->stop();
+        const size_t written = logger->get_total_written();
+        delete logger;
+        
+        ColumnarLogReader reader(path);
+        assert(reader.file_size() == written);
+        assert(reader.rows(MessageType::ADD_ORDER) == 150);
+        assert(reader.rows(MessageType::EXECUTE_ORDER) == 10);
+        (void)written;
+    }
+    std::remove(path.c_str());
+}
+
+TEST(compact_log) {
+    // Every ITCH type with random field bytes round-trips exactly
+    std::mt19937_64 rng(11);
+    std::vector<ParsedMessage> messages;
+    const char symbols[4][9] = {"AAPL    ", "MSFT    ", "QQQ     ", "ZVZZT   "};
+    for (int i = 0; i < 4000; ++i) {
+        const auto type = static_cast<MessageType>("SRHYLVWKJhAFECXDUPQBINO"[rng() % 23]);
+        ParsedMessage msg{};
+        msg.type = type;
+        auto* bytes = reinterpret_cast<uint8_t*>(&msg.system_event);
+        for (size_t b = 0; b < MESSAGE_LENGTHS[static_cast<uint8_t>(type)]; ++b) {
+            bytes[b] = static_cast<uint8_t>(rng());
+        }
+        msg.system_event.header.message_type = static_cast<uint8_t>(type);
+        msg.system_event.header.stock_locate = static_cast<uint16_t>(rng() % 4);
+        const int stock = ColumnarLogReader::column_index(type, "stock");
+        if (stock > 0 && rng() % 8 != 0) {
+            std::memcpy(bytes + columnar_schema(type).columns[stock].offset,
+                        symbols[msg.system_event.header.stock_locate], 8);
+        }
+        messages.push_back(msg);
+    }
+    
+    CompactEncoder encoder;
+    std::vector<uint8_t> encoded;
+    std::vector<size_t> resets;
+    for (size_t i = 0; i < messages.size(); ++i) {
+        if (i == 2500) {
+            encoder.reset();
+            resets.push_back(encoded.size());
+        }
+        uint8_t record[CompactEncoder::MAX_RECORD_SIZE];
+        const size_t size = encoder.encode(messages[i], record);
+        assert(size > 0 && size <= sizeof(record));
+        encoded.insert(encoded.end(), record, record + size);
+    }
+    
+    CompactDecoder decoder;
+    ParsedMessage decoded;
+    size_t offset = 0;
+    for (size_t i = 0; i < messages.size(); ++i) {
+        if (i == 2500) {
+            assert(offset == resets[0]);
+            decoder.reset();
+        }
+        const size_t used = decoder.decode(encoded.data() + offset, encoded.size() - offset, decoded);
+        assert(used > 0);
+        assert(decoded.type == messages[i].type);
+        assert(std::memcmp(&decoded.system_event, &messages[i].system_event,
+                           MESSAGE_LENGTHS[static_cast<uint8_t>(decoded.type)]) == 0);
+        offset += used;
+        (void)used;
+    }
+    assert(offset == encoded.size());
+    
+    // A record cut short is rejected rather than misread
+    CompactDecoder fresh;
+    assert(fresh.decode(encoded.data(), 3, decoded) == 0);
+    
+    // Order flow through the logger: sequential references and a repeated
+    // symbol shrink an add order to well under half its size
+    const std::string path = "test_compact.bin";
+    ITCHParser parser;
+    std::vector<ParsedMessage> flow;
+    for (uint64_t i = 0; i < 2000; ++i) {
+        auto add = make_book_add(5000 + i, 'B', 100, 1500000 + (i % 10) * 100, 3);
+        reinterpret_cast<AddOrderMessage*>(add.data())->header.timestamp = hton48(34200000000000ULL + i * 1000);
+        flow.push_back(*parser.parse(add.data(), add.size()));
+    }
+    {
+        AsyncLogger* logger = new AsyncLogger(path, AsyncLogger::WriteMode::COMPACT);
+        logger->start();
+        for (const ParsedMessage& msg : flow) {
+            while (!logger->log(msg)) {
+                std::this_thread::yield();
+            }
+        }
+        logger->stop();
+        delete logger;
+    }
+    {
+        CompactLogReader reader(path);
+        assert(reader.size() < flow.size() * sizeof(AddOrderMessage) / 2);
+        size_t index = 0;
+        const uint64_t records = reader.for_each([&](const ParsedMessage& msg) {
+            assert(std::memcmp(&msg.add_order, &flow[index].add_order, sizeof(AddOrderMessage)) == 0);
+            ++index;
+        });
+        assert(records == flow.size());
+        (void)records;
+    }
+    std::remove(path.c_str());
+}
+
+TEST(log_index) {
+    // 3000 adds, four per timestamp, through both indexable record formats
+    ITCHParser parser;
+    std::vector<ParsedMessage> flow;
+    auto timestamp_of = [](uint64_t i) { return 34200000000000ULL + (i / 4) * 1000; };
+    for (uint64_t i = 0; i < 3000; ++i) {
+        auto add = make_book_add(9000 + i, 'S', 200, 2000000 + (i % 50) * 100, static_cast<uint16_t>(1 + i % 3));
+        reinterpret_cast<AddOrderMessage*>(add.data())->header.timestamp = hton48(timestamp_of(i));
+        flow.push_back(*parser.parse(add.data(), add.size()));
+    }
+    
+    const std::string path = "test_indexed.bin";
+    for (const auto mode : {AsyncLogger::WriteMode::BUFFERED, AsyncLogger::WriteMode::COMPACT}) {
+        {
+            AsyncLogger* logger = new AsyncLogger(path, mode);
+            logger->enable_index(257, 0);
+            logger->start();
+            for (const ParsedMessage& msg : flow) {
+                while (!logger->log(msg)) {
+                    std::this_thread::yield();
+                }
+            }
+            logger->stop();
+            delete logger;
+        }
+        
+        IndexedLogReader reader(path);
+        assert(reader.entries().size() == (3000 + 256) / 257);
+        assert(reader.format() == (mode == AsyncLogger::WriteMode::COMPACT ? LogFormat::COMPACT : LogFormat::ROW));
+        
+        // Index points fall mid-timestamp, so earlier records with the same
+        // time must still be found
+        for (uint64_t target : {0ULL, 1ULL, 257ULL, 1029ULL, 2570ULL, 2999ULL}) {
+            uint64_t found = UINT64_MAX;
+            reader.scan_from_time(timestamp_of(target), [&](const ParsedMessage& msg, uint64_t ordinal) {
+                assert(std::memcmp(&msg.add_order, &flow[ordinal].add_order, sizeof(AddOrderMessage)) == 0);
+                found = ordinal;
+                return false;
+            });
+            assert(found == target / 4 * 4);
+            
+            std::vector<uint64_t> ordinals;
+            reader.scan_from_ordinal(target, [&](const ParsedMessage& msg, uint64_t ordinal) {
+                assert(msg.add_order.order_reference_number == 9000 + ordinal);
+                ordinals.push_back(ordinal);
+                return ordinals.size() < 3;
+            });
+            assert(ordinals.front() == target);
+            assert(ordinals.size() == std::min<uint64_t>(3, 3000 - target));
+        }
+        
+        // Segment markers keep an indexed compact log readable end to end
+        if (mode == AsyncLogger::WriteMode::COMPACT) {
+            CompactLogReader whole(path);
+            const uint64_t records = whole.for_each([](const ParsedMessage&) {});
+            assert(records == flow.size());
+            (void)records;
+        }
+        
+        // Past the end: nothing to visit
+        uint64_t visited = 0;
+        reader.scan_from_time(timestamp_of(5000), [&](const ParsedMessage&, uint64_t) { return ++visited != 0; });
+        assert(visited == 0);
+        (void)visited;
+    }
+    
+    // Time-based points: one per 10 us of feed time (40 records)
+    {
+        AsyncLogger* logger = new AsyncLogger(path, AsyncLogger::WriteMode::BUFFERED);
+        logger->enable_index(0, 10000);
+        logger->start();
+        for (const ParsedMessage& msg : flow) {
+            while (!logger->log(msg)) {
+                std::this_thread::yield();
+            }
+        }
+        logger->stop();
+        delete logger;
+        
+        IndexedLogReader reader(path);
+        assert(reader.entries().size() == 75);
+        assert(reader.entries()[1].ordinal == 40);
+        assert(reader.entries()[1].offset == 40 * sizeof(AddOrderMessage));
+    }
+    std::remove(path.c_str());
+    std::remove((path + ".idx").c_str());
+}
+
 TEST(system_utils_timestamp) {
     uint64_t ts1 = SystemUtils::rdtsc();
     
@@ -252,9 +1990,10 @@ TEST(message_size_calculation) {
     assert(sizeof(ExecuteOrderMessage) == 31);
     assert(sizeof(OrderCancelMessage) == 23);
     assert(sizeof(OrderDeleteMessage) == 19);
+    assert(sizeof(NOIIMessage) == 50);
     
     // Verify no padding in structs
-    assert(sizeof(ITCHMessageHeader) == 15);
+    assert(sizeof(ITCHMessageHeader) == 11);
 }
 
 int main() {
@@ -266,7 +2005,36 @@ int main() {
     RUN_TEST(parser_add_order);
     RUN_TEST(parser_execute_order);
     RUN_TEST(parser_invalid_message);
+    RUN_TEST(parser_batch_framing);
+    RUN_TEST(parser_stream_split_frames);
+    RUN_TEST(parser_handler_dispatch);
+    RUN_TEST(parser_all_message_types);
+    RUN_TEST(parser_new_message_fields);
+    RUN_TEST(message_views);
+    RUN_TEST(batch_header_decoder);
+    RUN_TEST(parser_subscription_mask);
+    RUN_TEST(symbol_filter);
+    RUN_TEST(parser_timestamp_modes);
+    RUN_TEST(moldudp64_sequencing);
+    RUN_TEST(moldudp64_trailing_frames);
+    RUN_TEST(soupbintcp_loopback_session);
+    RUN_TEST(pcap_replay);
+    RUN_TEST(parallel_file_parser);
+    RUN_TEST(gzip_stream_reader);
+    RUN_TEST(sharded_pipeline);
+    RUN_TEST(symbol_directory);
+    RUN_TEST(order_book_manager);
+    RUN_TEST(flat_order_map);
+    RUN_TEST(object_pool);
+    RUN_TEST(object_pool_huge_page_slabs);
+    RUN_TEST(price_ladder);
+    RUN_TEST(top_of_book);
+    RUN_TEST(book_checkpoint);
+    RUN_TEST(bar_aggregator);
     RUN_TEST(async_logger_basic);
+    RUN_TEST(columnar_log);
+    RUN_TEST(compact_log);
+    RUN_TEST(log_index);
     RUN_TEST(system_utils_timestamp);
     RUN_TEST(endian_conversion);
     RUN_TEST(price_conversion);